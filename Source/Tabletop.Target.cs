@@ -10,6 +10,7 @@ public class TabletopTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+		bWithPushModel = true;
 		ExtraModuleNames.Add("Tabletop");
 	}
 }
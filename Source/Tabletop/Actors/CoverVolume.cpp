@@ -5,6 +5,8 @@
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Tabletop/TabletopCoverRegistrySubsystem.h"
+#include "Tabletop/TabletopPushModel.h"
 #include "Tabletop/Gamemodes/MatchGameMode.h"
 #include "Tabletop/PlayerStates/TabletopPlayerState.h"
 
@@ -15,6 +17,9 @@ ACoverVolume::ACoverVolume()
 	PrimaryActorTick.bCanEverTick = false;
 	bReplicates = true;
 
+	// Hundreds per map and they only change on damage / presets: replicate once, then only on FlushNetDormancy
+	NetDormancy = DORM_DormantAll;
+
 #if WITH_EDITOR
 	// nicer editor UX (rename/undo/etc.)
 	SetFlags(RF_Transactional);
@@ -70,23 +75,44 @@ void ACoverVolume::BeginPlay()
 		const float Eps = kHealthEpsilonPct;
 		const float TargetPct = FMath::Clamp(HighToLowPct - Eps, 0.f, 1.f);
 		Health = FMath::Clamp(TargetPct * MaxHealth, 0.f, MaxHealth);
+		TABLETOP_MARK_DIRTY(ACoverVolume, Health, this);
 	}
 
 	// Establish a sane baseline; not a damage recompute.
 	bRecomputeAfterDamage = false;
 	LastAppliedType = ComputeTypeFromHealth();
 	ApplyStateVisuals(LastAppliedType);
+
+	if (UTabletopCoverRegistrySubsystem* Registry = UTabletopCoverRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterCover(this);
+	}
+	TabletopPushModel::TrackActor(this, /*bAdd*/true);
+}
+
+void ACoverVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UTabletopCoverRegistrySubsystem* Registry = UTabletopCoverRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterCover(this);
+	}
+	TabletopPushModel::TrackActor(this, /*bAdd*/false);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACoverVolume::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ACoverVolume, Health);
-	DOREPLIFETIME(ACoverVolume, HighMesh);
-	DOREPLIFETIME(ACoverVolume, LowMesh);
-	DOREPLIFETIME(ACoverVolume, NoneMesh);
-	DOREPLIFETIME(ACoverVolume, HighToLowPct);
+	FDoRepLifetimeParams Push;
+	Push.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACoverVolume, Health, Push);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACoverVolume, HighMesh, Push);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACoverVolume, LowMesh, Push);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACoverVolume, NoneMesh, Push);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACoverVolume, HighToLowPct, Push);
 }
 
 float ACoverVolume::GetLowStateHealthFraction() const
@@ -155,6 +181,12 @@ void ACoverVolume::ApplyStateVisuals(ECoverType NewType)
 
 	const bool bHasAnyCover = (NewType == ECoverType::High || NewType == ECoverType::Low);
 
+	// State transition on the server: wake the channel so clients get it even if nothing else flushed
+	if (NewType != LastAppliedType && HasAuthority() && IsGameWorld() && HasActorBegunPlay())
+	{
+		FlushNetDormancy();
+	}
+
 	// Collision on the simple box and the visual
 	Box->SetCollisionEnabled(bHasAnyCover ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
 	Box->SetCollisionResponseToAllChannels(ECR_Ignore);
@@ -187,12 +219,30 @@ void ACoverVolume::ApplyStateVisuals(ECoverType NewType)
 	}
 
 	LastAppliedType = NewType;
+
+	// Collision/mesh may have changed; refit our bounds (no-op before BeginPlay registers us)
+	if (HasActorBegunPlay())
+	{
+		if (UTabletopCoverRegistrySubsystem* Registry = UTabletopCoverRegistrySubsystem::Get(this))
+		{
+			Registry->UpdateCover(this);
+		}
+	}
 }
 
 void ACoverVolume::RecomputeFromHealth()
 {
 	const ECoverType NewType = ComputeTypeFromHealth();
 
+	// Cover state may change below (damage, preset, destruction); cached cover results on the server go stale
+	if (HasAuthority() && IsGameWorld())
+	{
+		if (AMatchGameMode* GM = GetWorld()->GetAuthGameMode<AMatchGameMode>())
+		{
+			GM->BumpCoverWorldVersion();
+		}
+	}
+
 	// Only the server in a real game world may destroy, and only immediately after damage.
 	const bool bServerCanDestroy =
 		HasAuthority() && IsGameWorld() && bDestroyOnZero && bRecomputeAfterDamage;
@@ -253,7 +303,9 @@ void ACoverVolume::SetHealthPercentImmediate(float Pct)
 	if (!HasAuthority()) return;
 
 	Pct = FMath::Clamp(Pct, 0.f, 1.f);
+	FlushNetDormancy();
 	Health = FMath::Clamp(MaxHealth * Pct, 0.f, MaxHealth);
+	TABLETOP_MARK_DIRTY(ACoverVolume, Health, this);
 	RecomputeFromHealth();
 
 	if (IsGameWorld())
@@ -264,10 +316,18 @@ void ACoverVolume::SetHealthPercentImmediate(float Pct)
 
 void ACoverVolume::ApplyPresetMeshes(UStaticMesh* InHigh, UStaticMesh* InLow, UStaticMesh* InNone)
 {
+	if (HasAuthority() && IsGameWorld()) { FlushNetDormancy(); }
+
 	HighMesh = InHigh;
 	LowMesh  = InLow;
 	NoneMesh = InNone;
 
+	// Callers set HighToLowPct right before this, so it rides along with the meshes
+	TABLETOP_MARK_DIRTY(ACoverVolume, HighMesh, this);
+	TABLETOP_MARK_DIRTY(ACoverVolume, LowMesh, this);
+	TABLETOP_MARK_DIRTY(ACoverVolume, NoneMesh, this);
+	TABLETOP_MARK_DIRTY(ACoverVolume, HighToLowPct, this);
+
 	bPresetInitialized = true;
 	bInitialized = true;
 
@@ -282,6 +342,7 @@ void ACoverVolume::ApplyPresetMeshes(UStaticMesh* InHigh, UStaticMesh* InLow, US
 	{
 		Health = FMath::Clamp(PendingHealth, 0.f, MaxHealth);
 		PendingHealth = -1.f;
+		TABLETOP_MARK_DIRTY(ACoverVolume, Health, this);
 	}
 
 	RecomputeFromHealth();
@@ -300,7 +361,9 @@ void ACoverVolume::ApplyCoverDamage(float Incoming)
 	if (Clamped <= 0.f)
 		return;
 
+	FlushNetDormancy();
 	Health = FMath::Clamp(Health - Clamped, 0.f, MaxHealth);
+	TABLETOP_MARK_DIRTY(ACoverVolume, Health, this);
 
 	// This recompute is damage-driven; allows Low->None destroy path.
 	bRecomputeAfterDamage = true;
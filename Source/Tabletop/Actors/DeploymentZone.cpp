@@ -7,22 +7,13 @@
 #include "GameFramework/PlayerState.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Tabletop/TabletopDeploymentZoneSubsystem.h"
 #include "Tabletop/Gamemodes/MatchGameMode.h"
 #include "Tabletop/PlayerStates/TabletopPlayerState.h"
 
 // Optional: tighten or loosen this if you want more/less spam
 static constexpr float GDeployDebugThrottleSeconds = 5.f;
 
-// Helper to stringify your EDeployOwner (adjust enum name if different)
-static FString DeployOwnerToString(EDeployOwner Owner)
-{
-    if (const UEnum* Enum = StaticEnum<EDeployOwner>())
-    {
-        return Enum->GetDisplayNameTextByValue(static_cast<int64>(Owner)).ToString();
-    }
-    return TEXT("UnknownOwner");
-}
-
 static FString FactionDisplay(EFaction F)
 {
     if (const UEnum* E = StaticEnum<EFaction>())
@@ -73,6 +64,15 @@ void ADeploymentZone::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& Ou
 void ADeploymentZone::BeginPlay()
 {
     Super::BeginPlay();
+
+    if (UTabletopDeploymentZoneSubsystem* Zones = UTabletopDeploymentZoneSubsystem::Get(this))
+    {
+        Zones->RegisterZone(this);
+    }
+    if (Zone)
+    {
+        Zone->TransformUpdated.AddUObject(this, &ADeploymentZone::HandleZoneTransformUpdated);
+    }
     
     if (UWorld* W = GetWorld())
     {
@@ -93,10 +93,46 @@ void ADeploymentZone::EndPlay(const EEndPlayReason::Type Reason)
             S->OnDeploymentChanged.RemoveDynamic(this, &ADeploymentZone::OnMatchChanged);
         }
     }
+
+    if (Zone)
+    {
+        Zone->TransformUpdated.RemoveAll(this);
+    }
+    if (UTabletopDeploymentZoneSubsystem* Zones = UTabletopDeploymentZoneSubsystem::Get(this))
+    {
+        Zones->UnregisterZone(this);
+    }
        
     Super::EndPlay(Reason);
 }
 
+void ADeploymentZone::NotifyZoneChanged()
+{
+    if (UTabletopDeploymentZoneSubsystem* Zones = UTabletopDeploymentZoneSubsystem::Get(this))
+    {
+        Zones->MarkDirty();
+    }
+}
+
+void ADeploymentZone::SetCurrentOwner(EDeployOwner NewOwner)
+{
+    if (CurrentOwner == NewOwner) return;
+    CurrentOwner = NewOwner;
+    OnRep_CurrentOwner(); // server doesn't get the OnRep; same cache + visual refresh
+}
+
+void ADeploymentZone::SetEnabled(bool bNewEnabled)
+{
+    if (bEnabled == bNewEnabled) return;
+    bEnabled = bNewEnabled;
+    OnRep_Enabled();
+}
+
+void ADeploymentZone::HandleZoneTransformUpdated(USceneComponent* Comp, EUpdateTransformFlags Flags, ETeleportType Teleport)
+{
+    NotifyZoneChanged();
+}
+
 void ADeploymentZone::OnMatchSignalChanged()
 {
     RefreshVisuals();
@@ -308,89 +344,34 @@ int32 ADeploymentZone::ResolvePlayerSlot(const APlayerController* PC)
 
 bool ADeploymentZone::IsLocationAllowedForTeam(const UWorld* World, int32 TeamNum, const FVector& WorldLocation)
 {
+    const UTabletopDeploymentZoneSubsystem* Zones = UTabletopDeploymentZoneSubsystem::Get(World);
+    const bool bAllowed = Zones && Zones->IsLocationAllowedForTeam(TeamNum, WorldLocation);
+
+#if !(UE_BUILD_SHIPPING)
     // ——— Debug throttle state ———
+    // Called every frame while deploying, so only the verdict is reported (was one line per zone per call)
     static float LastPrintTime = -1000.f;
     const float Now = World ? World->GetTimeSeconds() : 0.f;
 
-    auto Print = [&](const FString& Msg, const FColor& Color = FColor::Cyan)
-    {
-#if !(UE_BUILD_SHIPPING)
-        if (GEngine && World && (Now - LastPrintTime) > GDeployDebugThrottleSeconds)
-        {
-            GEngine->AddOnScreenDebugMessage(
-                /*Key*/ 991234, /*Time*/ GDeployDebugThrottleSeconds, Color, Msg);
-            LastPrintTime = Now;
-        }
-        UE_LOG(LogTemp, Log, TEXT("%s"), *Msg);
-#endif
-    };
+    const FString Msg = !Zones
+        ? TEXT("IsLocationAllowedForTeam: no zone subsystem (World is null?) → DENY")
+        : FString::Printf(TEXT("IsLocationAllowedForTeam: %s | Team=%d | ZonesForTeam=%d"),
+            bAllowed ? TEXT("ALLOW") : TEXT("DENY"), TeamNum, Zones->NumZonesForTeam(TeamNum));
 
-    if (!World)
-    {
-        Print(TEXT("IsLocationAllowedForTeam: World is null → DENY"), FColor::Red);
-        return false;
-    }
-    if (TeamNum <= 0)
+    if (GEngine && World && (Now - LastPrintTime) > GDeployDebugThrottleSeconds)
     {
-        Print(FString::Printf(TEXT("IsLocationAllowedForTeam: Bad TeamNum=%d → DENY"), TeamNum), FColor::Red);
-        return false;
+        GEngine->AddOnScreenDebugMessage(
+            /*Key*/ 991234, /*Time*/ GDeployDebugThrottleSeconds, bAllowed ? FColor::Green : FColor::Red, Msg);
+        LastPrintTime = Now;
     }
+    UE_LOG(LogTemp, Verbose, TEXT("%s"), *Msg);
+#endif
 
-    int32 ZonesVisited = 0;
-    int32 ZonesConsidered = 0;
-
-    for (TActorIterator<ADeploymentZone> It(World); It; ++It)
-    {
-        const ADeploymentZone* Z = *It;
-        ++ZonesVisited;
-
-        if (!Z)
-        {
-            Print(TEXT("Zone: <null> → skip"));
-            continue;
-        }
-
-        const FString ZoneName = GetNameSafe(Z);
-
-        if (!Z->bEnabled)
-        {
-            Print(FString::Printf(TEXT("Zone: %s disabled → skip"), *ZoneName));
-            continue;
-        }
-
-        const bool OwnerMatch =
-            (Z->CurrentOwner == EDeployOwner::Either) ||
-            (Z->CurrentOwner == EDeployOwner::Team1 && TeamNum == 1) ||
-            (Z->CurrentOwner == EDeployOwner::Team2 && TeamNum == 2);
-
-        ++ZonesConsidered;
-
-        const bool bInside = Z->ContainsLocation(WorldLocation);
-
-        Print(FString::Printf(
-            TEXT("Zone: %s | Owner=%s | TeamNum=%d | OwnerMatch=%s | Contains=%s"),
-            *ZoneName,
-            *DeployOwnerToString(Z->CurrentOwner),
-            TeamNum,
-            OwnerMatch ? TEXT("YES") : TEXT("NO"),
-            bInside ? TEXT("YES") : TEXT("NO")));
-
-        if (OwnerMatch && bInside)
-        {
-            Print(FString::Printf(
-                TEXT("IsLocationAllowedForTeam: ALLOW in zone %s for Team %d"),
-                *ZoneName, TeamNum), FColor::Green);
-            //DrawDebugSphere(World, WorldLocation, 50.f, 12, FColor::Green, false, 5.f, 0, 2.f);
-            return true;
-        }
-    }
-
-    Print(FString::Printf(
-        TEXT("IsLocationAllowedForTeam: DENY | Team=%d | ZonesVisited=%d | ZonesConsidered=%d"),
-        TeamNum, ZonesVisited, ZonesConsidered), FColor::Red);
-
-    //DrawDebugSphere(World, WorldLocation, 50.f, 12, FColor::Red, false, 5.f, 0, 2.f);
+    return bAllowed;
+}
 
-    
-    return false;
-}
\ No newline at end of file
+bool ADeploymentZone::AreLocationsAllowedForTeam(const UWorld* World, int32 TeamNum, TConstArrayView<FVector> WorldLocations)
+{
+    const UTabletopDeploymentZoneSubsystem* Zones = UTabletopDeploymentZoneSubsystem::Get(World);
+    return Zones && Zones->AreLocationsAllowedForTeam(TeamNum, WorldLocations);
+}
@@ -22,8 +22,11 @@ class TABLETOP_API ADeploymentZone : public AActor
 public:
     ADeploymentZone();
 
-    // New: team-based query
+    // New: team-based query (served from UTabletopDeploymentZoneSubsystem's cached bounds)
     static bool IsLocationAllowedForTeam(const UWorld* World, int32 TeamNum, const FVector& WorldLocation);
+
+    // Whole formation in one go; true only if every location is allowed
+    static bool AreLocationsAllowedForTeam(const UWorld* World, int32 TeamNum, TConstArrayView<FVector> WorldLocations);
     
     UPROPERTY(EditDefaultsOnly, Category="Visual") class UMaterialInterface* DecalMaterial = nullptr;
     UPROPERTY(EditDefaultsOnly, Category="Visual") FLinearColor Team1Color = FLinearColor(0.10f,0.55f,1.f,0.35f);
@@ -34,14 +37,27 @@ public:
     UFUNCTION()
     void OnRep_Enabled()
     {
+        NotifyZoneChanged();
         RefreshVisuals();
     }
     
     UFUNCTION()
     void OnRep_CurrentOwner()
     {
+        NotifyZoneChanged();
         RefreshVisuals();
     }
+
+    /** Call after changing bEnabled / CurrentOwner at runtime so cached deploy lookups pick it up (OnReps do this on clients) */
+    UFUNCTION(BlueprintCallable, Category="Deploy")
+    void NotifyZoneChanged();
+
+    /** Server/Blueprint writes go through these so the deploy cache and visuals update where OnReps don't run */
+    UFUNCTION(BlueprintSetter)
+    void SetCurrentOwner(EDeployOwner NewOwner);
+
+    UFUNCTION(BlueprintSetter)
+    void SetEnabled(bool bNewEnabled);
     
     
     /** Axis-aligned box in this actor's local space; rotation/scaling supported via actor transform */
@@ -49,7 +65,7 @@ public:
     UBoxComponent* Zone;
 
     /** Which player(s) may deploy here */
-    UPROPERTY(ReplicatedUsing=OnRep_CurrentOwner, EditAnywhere, BlueprintReadWrite, Category="Deploy")
+    UPROPERTY(ReplicatedUsing=OnRep_CurrentOwner, EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetCurrentOwner, Category="Deploy")
     EDeployOwner CurrentOwner = EDeployOwner::Either;
 
     /** Treat check as 2D (ignore Z) — usually desirable for top-down/tabletop */
@@ -57,7 +73,7 @@ public:
     bool bUse2DCheck = true;
 
     /** Optional toggle if you want to disable a zone at runtime and replicate that */
-    UPROPERTY(ReplicatedUsing=OnRep_Enabled, EditAnywhere, BlueprintReadWrite, Category="Deploy")
+    UPROPERTY(ReplicatedUsing=OnRep_Enabled, EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetEnabled, Category="Deploy")
     bool bEnabled = true;
 
     /** Does this world-space location lie in the zone (respecting bUse2DCheck)? */
@@ -104,6 +120,8 @@ public:
     float OwnerTextZOffset = 20.f; // extra lift above box center
 
 private:
+    void HandleZoneTransformUpdated(USceneComponent* Comp, EUpdateTransformFlags Flags, ETeleportType Teleport);
+
     // spawned client-side
     UPROPERTY(Transient) class UDecalComponent*   ZoneDecal   = nullptr;
     UPROPERTY(Transient) class UTextRenderComponent* Label3D  = nullptr;
@@ -5,10 +5,14 @@
 #include "UnitBase.h"
 #include "Components/SphereComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Tabletop/TabletopPushModel.h"
+#include "Tabletop/TabletopSpatialIndexSubsystem.h"
+#include "Tabletop/Gamemodes/MatchGameMode.h"
 
 AObjectiveMarker::AObjectiveMarker()
 {
 	bReplicates = true;
+	NetDormancy = DORM_DormantAll; // woken only when Contestants / controller change
 
 	Sphere = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere"));
 	RootComponent = Sphere;
@@ -21,6 +25,19 @@ void AObjectiveMarker::BeginPlay()
 	Super::BeginPlay();
 	RecalcRadius();
 
+	// Sublevel markers stream in after the game state's BeginPlay scan, so every marker checks in itself
+	if (AMatchGameState* GS = GetWorld() ? GetWorld()->GetGameState<AMatchGameState>() : nullptr)
+	{
+		GS->RegisterObjective(this);
+	}
+
+	// Seed the occupant set once; units keep it current from here (AUnitBase::BumpTransformVersion/EndPlay)
+	if (HasAuthority())
+	{
+		RecalculateControl();
+	}
+	TabletopPushModel::TrackActor(this, /*bAdd*/true);
+
 #if !(UE_BUILD_SHIPPING)
 	if (bDrawDebug && HasAuthority())
 	{
@@ -29,6 +46,16 @@ void AObjectiveMarker::BeginPlay()
 #endif
 }
 
+void AObjectiveMarker::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	TabletopPushModel::TrackActor(this, /*bAdd*/false);
+	if (AMatchGameState* GS = GetWorld() ? GetWorld()->GetGameState<AMatchGameState>() : nullptr)
+	{
+		GS->UnregisterObjective(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 #if WITH_EDITOR
 void AObjectiveMarker::PostEditChangeProperty(FPropertyChangedEvent& E)
 {
@@ -47,52 +74,131 @@ void AObjectiveMarker::RecalculateControl()
 {
 	if (!HasAuthority()) return;
 
-	// Sum OC per PlayerState on the server
-	TMap<APlayerState*, int32> Sum;
+	Occupants.Reset();
 	for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
 	{
-		AUnitBase* Unit = *It;
-		if (!Unit) continue;
+		NotifyUnitChanged(*It);
+	}
+	RefreshControlFromOccupants();
+}
 
-		// Replace 'OwningPS' with whatever you store for unit ownership
-		APlayerState* PS = Unit->OwningPS;
-		if (!PS) continue;
+void AObjectiveMarker::NotifyUnitChanged(AUnitBase* Unit)
+{
+	if (!HasAuthority() || !Unit) return;
 
-		const int32 OC = Unit->GetObjectiveControlAt(this); // per-model OC from the unit
-		if (OC <= 0) continue;
+	const int32 Existing = Occupants.IndexOfByPredicate([Unit](const FOccupant& O){ return O.Unit.Get() == Unit; });
 
-		Sum.FindOrAdd(PS) += OC;
+	// Not in the set and too far to have a model inside: nothing to do.
+	// No model sits farther than the unit's model reach from its centre, so centre distance (2D) > radius + reach rules it out.
+	// The spatial index has already re-bucketed the unit by the time we're told; before it's indexed, measure the models directly.
+	TArray<FVector> ModelLocs;
+	if (Existing == INDEX_NONE)
+	{
+		const FVector Centre = Unit->GetActorLocation();
+		float Reach = 0.f;
+		const UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(this);
+		if (!Index || !Index->GetModelReach(Unit, Reach))
+		{
+			Unit->GetModelWorldLocations(ModelLocs);
+			for (const FVector& L : ModelLocs) Reach = FMath::Max(Reach, (float)FVector::Dist2D(L, Centre));
+		}
+		const float Watch = RadiusCm + Reach;
+		if (FVector::DistSquared2D(Centre, GetActorLocation()) > Watch * Watch) return;
 	}
 
-	// Build replicated snapshot
-	Contestants.Reset(Sum.Num());
-	for (const TPair<APlayerState*, int32>& KV : Sum)
+	if (ModelLocs.Num() == 0) Unit->GetModelWorldLocations(ModelLocs);
+	int32 ModelsIn = 0;
+	if (Unit->ModelsCurrent > 0)
 	{
-		FObjectiveContestant C;
-		C.PlayerState = KV.Key;
-		C.ObjectiveControl = KV.Value;
-		Contestants.Add(C);
+		for (const FVector& L : ModelLocs)
+		{
+			if (IsInside(L)) ++ModelsIn;
+		}
+	}
+
+	const int32 OC = ModelsIn * FMath::Max(0, Unit->ObjectiveControlPerModel);
+	if (ModelsIn > 0 && Unit->OwningPS)
+	{
+		FOccupant& O = (Existing == INDEX_NONE) ? Occupants.AddDefaulted_GetRef() : Occupants[Existing];
+		const bool bChanged = (Existing == INDEX_NONE) || O.ModelsInside != ModelsIn || O.OC != OC || O.PlayerState.Get() != Unit->OwningPS;
+		O.Unit         = Unit;
+		O.PlayerState  = Unit->OwningPS;
+		O.ModelsInside = ModelsIn;
+		O.OC           = OC;
+		if (bChanged) RefreshControlFromOccupants();
+	}
+	else if (Existing != INDEX_NONE)
+	{
+		Occupants.RemoveAtSwap(Existing);
+		RefreshControlFromOccupants();
+	}
+}
+
+void AObjectiveMarker::NotifyUnitRemoved(AUnitBase* Unit)
+{
+	if (!HasAuthority()) return;
+	const int32 Removed = Occupants.RemoveAllSwap([Unit](const FOccupant& O){ return !O.Unit.IsValid() || O.Unit.Get() == Unit; });
+	if (Removed > 0) RefreshControlFromOccupants();
+}
+
+bool AObjectiveMarker::IsOccupiedBy(const AUnitBase* Unit) const
+{
+	return Unit && Occupants.ContainsByPredicate([Unit](const FOccupant& O){ return O.Unit.Get() == Unit && O.OC > 0; });
+}
+
+int32 AObjectiveMarker::GetObjectiveControlFor(const APlayerState* PS) const
+{
+	for (const FObjectiveContestant& C : Contestants)
+	{
+		if (C.PlayerState == PS) return C.ObjectiveControl;
+	}
+	return 0;
+}
+
+void AObjectiveMarker::RefreshControlFromOccupants()
+{
+	// Sum OC per PlayerState from the occupant set
+	TArray<FObjectiveContestant, TInlineAllocator<4>> Sum;
+	for (const FOccupant& O : Occupants)
+	{
+		if (!O.Unit.IsValid() || !O.PlayerState.IsValid() || O.OC <= 0) continue;
+
+		FObjectiveContestant* C = Sum.FindByPredicate([&O](const FObjectiveContestant& X){ return X.PlayerState == O.PlayerState.Get(); });
+		if (!C)
+		{
+			C = &Sum.AddDefaulted_GetRef();
+			C->PlayerState = O.PlayerState.Get();
+		}
+		C->ObjectiveControl += O.OC;
 	}
 
 	// Sort by OC desc for nice UI (top[0] is the leader)
-	Contestants.Sort([](const FObjectiveContestant& A, const FObjectiveContestant& B)
+	Sum.Sort([](const FObjectiveContestant& A, const FObjectiveContestant& B)
 	{
 		return A.ObjectiveControl > B.ObjectiveControl;
 	});
 
 	// Decide controller: highest OC strictly greater than second highest
-	if (Contestants.Num() == 0 || Contestants[0].ObjectiveControl <= 0)
-	{
-		ControllingPS = nullptr;
-	}
-	else if (Contestants.Num() >= 2 && Contestants[0].ObjectiveControl == Contestants[1].ObjectiveControl)
+	APlayerState* NewController = nullptr;
+	if (Sum.Num() > 0 && Sum[0].ObjectiveControl > 0)
 	{
-		ControllingPS = nullptr; // contested tie
+		const bool bTie = Sum.Num() >= 2 && Sum[0].ObjectiveControl == Sum[1].ObjectiveControl;
+		NewController = bTie ? nullptr : Sum[0].PlayerState; // contested tie -> nobody
 	}
-	else
+
+	bool bSame = (NewController == ControllingPS) && (Sum.Num() == Contestants.Num());
+	for (int32 i = 0; bSame && i < Sum.Num(); ++i)
 	{
-		ControllingPS = Contestants[0].PlayerState;
+		bSame = Sum[i].PlayerState == Contestants[i].PlayerState && Sum[i].ObjectiveControl == Contestants[i].ObjectiveControl;
 	}
+	if (bSame) return;
+
+	FlushNetDormancy();
+	Contestants.Reset(Sum.Num());
+	Contestants.Append(Sum);
+	ControllingPS = NewController;
+	TABLETOP_MARK_DIRTY(AObjectiveMarker, Contestants, this);
+	TABLETOP_MARK_DIRTY(AObjectiveMarker, ControllingPS, this);
 
 	// Net notify
 	ForceNetUpdate();
@@ -117,6 +223,9 @@ void AObjectiveMarker::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AObjectiveMarker, Contestants);
-	DOREPLIFETIME(AObjectiveMarker, ControllingPS);
+	FDoRepLifetimeParams Push;
+	Push.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(AObjectiveMarker, Contestants, Push);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AObjectiveMarker, ControllingPS, Push);
 }
\ No newline at end of file
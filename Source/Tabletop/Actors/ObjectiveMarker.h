@@ -7,6 +7,7 @@
 #include "ObjectiveMarker.generated.h"
 
 class USphereComponent;
+class AUnitBase;
 USTRUCT(BlueprintType)
 struct FObjectiveContestant
 {
@@ -47,10 +48,22 @@ public:
 	
 	// ---- Queries / API ----
 
-	/** Server: recompute contestants and controlling PS from current unit positions. */
+	/** Server: full rescan of every unit. Normal play keeps control current incrementally (NotifyUnitChanged). */
 	UFUNCTION(BlueprintCallable, Category="Objective")
 	void RecalculateControl();
 
+	/** Server: a unit moved, re-laid its models or lost models. Cheap reject when it can't matter to us. */
+	void NotifyUnitChanged(AUnitBase* Unit);
+
+	/** Server: a unit left play. */
+	void NotifyUnitRemoved(AUnitBase* Unit);
+
+	/** At least one of this unit's models is inside (cached, no scan). */
+	bool IsOccupiedBy(const AUnitBase* Unit) const;
+
+	/** Cached OC this player has on the marker. */
+	int32 GetObjectiveControlFor(const APlayerState* PS) const;
+
 	/** Is world location inside the scoring radius (cheap distance check). */
 	UFUNCTION(BlueprintPure, Category="Objective")
 	bool IsInside(const FVector& WorldLoc) const
@@ -68,6 +81,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& E) override;
 #endif
@@ -83,6 +97,19 @@ private:
 	float RadiusSq = 0.f;
 	void RecalcRadius(); // update Sphere radius & RadiusSq
 
+	// ---- Server occupant set: units with at least one model inside ----
+	struct FOccupant
+	{
+		TWeakObjectPtr<AUnitBase> Unit;
+		TWeakObjectPtr<APlayerState> PlayerState; // weak: FOccupant is not a UPROPERTY, GC can't see it
+		int32 ModelsInside = 0;
+		int32 OC = 0;
+	};
+	TArray<FOccupant> Occupants;
+
+	// Rebuild Contestants/ControllingPS from Occupants; only dirties replication when something changed
+	void RefreshControlFromOccupants();
+
 	// ---- Replicated control state ----
 
 	/** Sorted descending by OC. Server writes, clients read. */
@@ -4,6 +4,7 @@
 #include "EngineUtils.h"
 #include "Tabletop/CombatEffects.h"
 #include "Tabletop/AbiltyEventSubsystem.h"            // (spelling matches your project)
+#include "Tabletop/TabletopSpatialIndexSubsystem.h"
 #include "Tabletop/UnitActionResourceComponent.h"
 #include "Tabletop/Controllers/MatchPlayerController.h"
 #include "Tabletop/Gamemodes/MatchGameMode.h"
@@ -32,20 +33,14 @@ static void GatherFriendliesWithin(AUnitBase* U, float RangeInches, bool bInclud
 	if (!U) return;
 	UWorld* World = U->GetWorld(); if (!World) return;
 
-	const float Rcm = RangeInches * CmPerInch(World);
-	const float R2  = Rcm * Rcm;
-	const FVector MyLoc = U->GetActorLocation();
+	const UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(World);
+	if (!Index) return;
 
-	for (TActorIterator<AUnitBase> It(World); It; ++It)
-	{
-		AUnitBase* Other = *It;
-		if (!Other) continue;
-		if (!bIncludeSelf && Other == U) continue;
-		if (Other->OwningPS != U->OwningPS) continue;
-
-		const bool bInRange = FVector::DistSquared(MyLoc, Other->GetActorLocation()) <= R2;
-		if (bInRange) Out.Add(Other);
-	}
+	FUnitSpatialFilter F;
+	F.Team       = U->OwningPS;
+	F.Exclude    = bIncludeSelf ? nullptr : U;
+	F.bAliveOnly = false;
+	Index->QueryRadius(U->GetActorLocation(), RangeInches * CmPerInch(World), F, Out);
 }
 
 // ====================== UUnitAction (base) ======================
@@ -165,6 +160,7 @@ void UAction_Advance::Execute_Implementation(AUnitBase* Unit, const FActionRunti
 	if (Unit->HasAuthority() && Desc.NextPhaseAPCost > 0)
 	{
 		Unit->NextPhaseAPDebt = FMath::Clamp(Unit->NextPhaseAPDebt + Desc.NextPhaseAPCost, 0, 255);
+		Unit->MarkAPDebtDirty();
 		Unit->ForceNetUpdate();
 	}
 
@@ -270,6 +266,7 @@ void UAction_Overwatch::Execute_Implementation(AUnitBase* Unit, const FActionRun
 	if (Unit->HasAuthority())
 	{
 		Unit->bOverwatchVisibleToEnemies = true;  // telegraph to enemies
+		Unit->MarkOverwatchDirty();
 		Unit->SetOverwatchArmed(true);
 		Unit->BumpUsage(Desc);
 		Unit->ForceNetUpdate();
@@ -549,6 +546,7 @@ void UAction_FieldMedic::BeginPreview_Implementation(AUnitBase* U)
 		GatherFriendliesWithin(U, 12.f, /*bIncludeSelf*/true, Potentials);
 		GS->Multicast_SetPotentialAllies(Potentials);
 		GS->ActionPreview.Attacker = U;
+		GS->MarkPreviewDirty();
 	}
 }
 
@@ -569,25 +567,13 @@ AUnitBase* UAction_FieldMedic::FindClosestAllyWithin12(AUnitBase* U) const
 	const AMatchGameMode* GM = World->GetAuthGameMode<AMatchGameMode>();
 	const float cmPerIn = GM ? GM->CmPerTabletopInch() : 2.54f * 20.f; // conservative fallback scale
 	const float Rcm = 12.f * cmPerIn;
-	const float R2  = Rcm * Rcm;
 
-	AUnitBase* Best = nullptr;
-	float BestD2 = R2;
+	const UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(World);
+	if (!Index) return nullptr;
 
-	const FVector MyLoc = U->GetActorLocation();
-
-	for (TActorIterator<AUnitBase> It(World); It; ++It)
-	{
-		AUnitBase* Other = *It;
-		if (!Other || Other == U) continue;
-		if (Other->OwningPS != U->OwningPS) continue; // friendly only
-
-		const float D2 = FVector::DistSquared(MyLoc, Other->GetActorLocation());
-		if (D2 <= BestD2)
-		{
-			BestD2 = D2;
-			Best   = Other;
-		}
-	}
-	return Best;
+	FUnitSpatialFilter F;
+	F.Team       = U->OwningPS; // friendly only
+	F.Exclude    = U;
+	F.bAliveOnly = false;
+	return Index->FindNearest(U->GetActorLocation(), Rcm, F);
 }
@@ -6,11 +6,17 @@
 #include "Net/UnrealNetwork.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMeshSocket.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 #include "UnitAbility.h"
 #include "UnitAction.h"
 #include "Kismet/GameplayStatics.h"
+#include "Tabletop/Tabletop.h"
+#include "Tabletop/TabletopFXPoolSubsystem.h"
+#include "Tabletop/TabletopPushModel.h"
+#include "Tabletop/TabletopSpatialIndexSubsystem.h"
 #include "Tabletop/UnitActionResourceComponent.h"
 #include "Tabletop/WeaponKeywordHelpers.h"
 #include "Tabletop/Controllers/MatchPlayerController.h"
@@ -18,6 +24,21 @@
 #include "Tabletop/PlayerStates/TabletopPlayerState.h"
 
 
+// Server: let objective markers update their occupant sets (each rejects far-away units cheaply)
+static void NotifyObjectivesOfUnit(AUnitBase* U, bool bRemoved)
+{
+    if (!U || !U->HasAuthority()) return;
+    const AMatchGameState* GS = U->GetWorld() ? U->GetWorld()->GetGameState<AMatchGameState>() : nullptr;
+    if (!GS) return;
+
+    for (AObjectiveMarker* Obj : GS->Objectives)
+    {
+        if (!IsValid(Obj)) continue;
+        if (bRemoved) Obj->NotifyUnitRemoved(U);
+        else          Obj->NotifyUnitChanged(U);
+    }
+}
+
 AUnitBase::AUnitBase()
 {
     bReplicates = true;
@@ -33,6 +54,19 @@ AUnitBase::AUnitBase()
     SelectCollision->SetCollisionResponseToAllChannels(ECR_Ignore);
     SelectCollision->SetCollisionResponseToChannel(ECC_GameTraceChannel2, ECR_Block);
 
+    ModelInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("ModelInstances"));
+    ModelInstances->SetupAttachment(RootComponent);
+    ModelInstances->SetMobility(EComponentMobility::Movable);
+    ModelInstances->SetCanEverAffectNavigation(false);
+    ModelInstances->SetRenderCustomDepth(false);
+    ModelInstances->NumCustomDataFloats = 1; // [0] = EUnitHighlight
+    ModelInstances->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    ModelInstances->SetGenerateOverlapEvents(false);
+    ModelInstances->SetCollisionResponseToAllChannels(ECR_Ignore);
+    ModelInstances->SetCollisionResponseToChannel(ECC_GameTraceChannel2 /*selection*/, ECR_Block);
+
+    ActiveCombatMods.Owner = this;
+
     ActionPoints = CreateDefaultSubobject<UUnitActionResourceComponent>(TEXT("ActionPoints"));
     ActionPoints->SetIsReplicated(true);
 
@@ -77,6 +111,43 @@ void AUnitBase::BeginPlay()
         RebuildFormation();
     }
     UpdateOverwatchIndicatorLocal();
+
+    if (UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(this))
+    {
+        Index->RegisterUnit(this);
+    }
+    NotifyObjectivesOfUnit(this, /*bRemoved*/false);
+    TabletopPushModel::TrackActor(this, /*bAdd*/true);
+}
+
+void AUnitBase::EndPlay(const EEndPlayReason::Type Reason)
+{
+    if (UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(this))
+    {
+        Index->UnregisterUnit(this);
+    }
+    NotifyObjectivesOfUnit(this, /*bRemoved*/true);
+    TabletopPushModel::TrackActor(this, /*bAdd*/false);
+    Super::EndPlay(Reason);
+}
+
+void AUnitBase::PostNetReceiveLocationAndRotation()
+{
+    Super::PostNetReceiveLocationAndRotation();
+    BumpTransformVersion(); // clients: replicated movement landed
+}
+
+void AUnitBase::BumpTransformVersion()
+{
+    ++TransformVersion;
+    if (HasActorBegunPlay())
+    {
+        if (UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(this))
+        {
+            Index->UpdateUnit(this);
+        }
+        NotifyObjectivesOfUnit(this, /*bRemoved*/false);
+    }
 }
 
 void AUnitBase::EnsureRangeDecal()
@@ -200,6 +271,7 @@ void AUnitBase::SetOverwatchArmed(bool bArmed)
     if (bOverwatchArmed == bArmed) return;
 
     bOverwatchArmed = bArmed;
+    MarkOverwatchDirty();
     ForceNetUpdate();
 
     // Listen server immediate refresh
@@ -377,6 +449,8 @@ void AUnitBase::Server_InitFromRow(APlayerState* OwnerPS, const FUnitRow& Row, i
     FeelNoPainRep       = FMath::Clamp(Row.FeelNoPain, 2, 7);
 
     WoundsPool = ModelsMax * FMath::Max(1, WoundsRep);
+    PackStatSnapshot();
+    PackHealthState();
 
     MoveMaxInches    = static_cast<float>(Row.MoveInches);
     MoveBudgetInches = 0.f;
@@ -390,6 +464,7 @@ void AUnitBase::Server_InitFromRow(APlayerState* OwnerPS, const FUnitRow& Row, i
     SndAttenuation  = Row.SndAttenuation;
     SndConcurrency  = Row.SndConcurrency;
     ImpactDelaySeconds = Row.ImpactDelaySeconds;
+    OnRep_VFXAudio(); // listen server: prime the pool like clients do
 
     if (Row.Weapons.Num() > 0)
     {
@@ -428,8 +503,14 @@ void AUnitBase::Server_InitFromRow(APlayerState* OwnerPS, const FUnitRow& Row, i
     bMovedThisTurn    = false;
     bAdvancedThisTurn = false;
 
+    MarkInitStateDirty();
     RebuildFormation();
     ForceNetUpdate();
+
+    if (AMatchGameMode* GM = GetWorld()->GetAuthGameMode<AMatchGameMode>())
+    {
+        GM->RegisterTeamUnit(this);
+    }
 }
 
 void AUnitBase::OnRep_AbilityClasses()
@@ -562,6 +643,8 @@ void AUnitBase::SyncWeaponSnapshotsFromCurrent()
     WeaponSkillToHitRep  = CurrentWeapon.SkillToHit;
     WeaponStrengthRep    = CurrentWeapon.Strength;
     WeaponAPRep          = CurrentWeapon.AP;
+
+    CompiledKeywords = FCompiledKeywordSet::Build(CurrentWeapon.Keywords);
 }
 
 void AUnitBase::ApplyAPPhaseStart(ETurnPhase Phase)
@@ -579,10 +662,11 @@ void AUnitBase::ApplyAPPhaseStart(ETurnPhase Phase)
     const int32 Debt = FMath::Max(0, NextPhaseAPDebt);
     NewMax = FMath::Max(0, NewMax - Debt);
     NextPhaseAPDebt = 0; // consumed now
+    MarkAPDebtDirty();
 
     // 2) Assault: +1 AP in Shooting phase (new rule, no Advance requirement)
     if (Phase == ETurnPhase::Shoot &&
-        UWeaponKeywordHelpers::HasKeyword(GetActiveWeaponProfile(), EWeaponKeyword::Assault))
+        CompiledKeywords.Has(EWeaponKeyword::Assault))
     {
         ++NewMax;
     }
@@ -598,15 +682,15 @@ void AUnitBase::ApplyAPPhaseStart(ETurnPhase Phase)
         }
     }
 
-    if (bGiveObjectiveAP)
+    const AMatchGameState* ObjGS = GetWorld() ? GetWorld()->GetGameState<AMatchGameState>() : nullptr;
+    if (bGiveObjectiveAP && ObjGS)
     {
-        // Iterate objectives and check control + presence
-        for (TActorIterator<AObjectiveMarker> It(GetWorld()); It; ++It)
+        // Cached control + occupant sets; no scans
+        for (const AObjectiveMarker* Obj : ObjGS->Objectives)
         {
-            const AObjectiveMarker* Obj = *It;
             if (!Obj) continue;
 
-            if (Obj->GetControllingPlayerState() == OwningPS && GetObjectiveControlAt(Obj) > 0)
+            if (Obj->GetControllingPlayerState() == OwningPS && Obj->IsOccupiedBy(this))
             {
                 ++NewMax; // only +1 even if standing in multiple; break after first
                 break;
@@ -621,20 +705,55 @@ void AUnitBase::ApplyAPPhaseStart(ETurnPhase Phase)
     ForceNetUpdate();
 }
 
+void AUnitBase::CacheModelSockets()
+{
+    CachedSocketMesh   = ModelMesh;
+    bHasMuzzleSocket   = false;
+    bHasImpactSocket   = false;
+    MuzzleSocketLocal  = FTransform::Identity;
+    ImpactSocketLocal  = FTransform::Identity;
+    if (!ModelMesh) return;
+
+    auto Read = [this](FName Name, FTransform& Out) -> bool
+    {
+        const UStaticMeshSocket* S = Name.IsNone() ? nullptr : ModelMesh->FindSocket(Name);
+        if (!S) return false;
+        Out = FTransform(S->RelativeRotation, S->RelativeLocation, S->RelativeScale);
+        return true;
+    };
+    bHasMuzzleSocket = Read(MuzzleSocketName, MuzzleSocketLocal);
+    bHasImpactSocket = Read(ImpactSocketName, ImpactSocketLocal);
+}
+
+FTransform AUnitBase::GetModelWorldTransform(int32 ModelIndex) const
+{
+    if (!ModelLocalXforms.IsValidIndex(ModelIndex) || !ModelInstances)
+        return GetActorTransform();
+
+    return ModelLocalXforms[ModelIndex] * ModelInstances->GetComponentTransform();
+}
+
+FVector AUnitBase::GetModelImpactPoint(int32 ModelIndex) const
+{
+    const FTransform WT = GetModelWorldTransform(ModelIndex);
+    return bHasImpactSocket
+        ? (ImpactSocketLocal * WT).GetLocation()
+        : WT.TransformPosition(ImpactOffsetLocal);
+}
+
 FTransform AUnitBase::GetMuzzleTransform(int32 ModelIndex) const
 {
-    if (!ModelMeshes.IsValidIndex(ModelIndex) || !ModelMeshes[ModelIndex])
+    if (!ModelLocalXforms.IsValidIndex(ModelIndex))
         return GetActorTransform();
 
-    UStaticMeshComponent* C = ModelMeshes[ModelIndex];
+    const FTransform WT = GetModelWorldTransform(ModelIndex);
 
-    if (C->DoesSocketExist(MuzzleSocketName))
+    if (bHasMuzzleSocket)
     {
-        return C->GetSocketTransform(MuzzleSocketName, ERelativeTransformSpace::RTS_World);
+        return MuzzleSocketLocal * WT;
     }
 
-    const FTransform WT = C->GetComponentTransform();
-    const FVector   WLoc = WT.TransformPosition(MuzzleOffsetLocal);
+    const FVector WLoc = WT.TransformPosition(MuzzleOffsetLocal);
 
     // Keep the mesh’s world rotation; no FacingYawOffsetDeg here
     return FTransform(WT.GetRotation(), WLoc, WT.GetScale3D());
@@ -642,42 +761,47 @@ FTransform AUnitBase::GetMuzzleTransform(int32 ModelIndex) const
 
 void AUnitBase::Multicast_PlayMuzzleAndImpactFX_AllModels_WithSites_Implementation(const FVector& TargetCenter, const TArray<FImpactSite>& Sites, float DelaySeconds)
 {
+    UTabletopFXPoolSubsystem* Pool = UTabletopFXPoolSubsystem::Get(this);
+    if (!Pool) return;
+
     // ---- MUZZLE (aim from each muzzle to the provided target center) ----
-    for (int32 i = 0; i < ModelMeshes.Num(); ++i)
+    TArray<int32> Shown;
+    UTabletopFXPoolSubsystem::PickRepresentatives(GetNumModelVisuals(), FXVolleyAggregateAbove, FXVolleyRepresentatives, Shown);
+    for (const int32 i : Shown)
     {
-        UStaticMeshComponent* C = ModelMeshes[i];
-        if (!IsValid(C)) continue;
-
         const FTransform Muzz = GetMuzzleTransform(i);
         const FVector MuzzLoc = Muzz.GetLocation();
         const FRotator AimRot = (TargetCenter - MuzzLoc).Rotation();
 
-        if (FX_Muzzle) UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), FX_Muzzle, MuzzLoc, AimRot);
-        if (Snd_Muzzle) UGameplayStatics::PlaySoundAtLocation(this, Snd_Muzzle, MuzzLoc, 1.f, 1.f, 0.f, SndAttenuation, SndConcurrency);
+        if (FX_Muzzle) Pool->SpawnOneShot(FX_Muzzle, MuzzLoc, AimRot);
+        if (Snd_Muzzle) Pool->PlayOneShotSound(Snd_Muzzle, MuzzLoc, SndAttenuation, SndConcurrency);
     }
 
     // ---- IMPACT (use only cached sites; target actor can be gone) ----
-    TArray<FImpactSite> SitesCopy = Sites; // capture by value for lambda safety
+    TArray<FImpactSite> SitesCopy; // capture by value for lambda safety; only the sites we'll actually render
+    UTabletopFXPoolSubsystem::PickRepresentatives(Sites.Num(), FXVolleyAggregateAbove, FXVolleyRepresentatives, Shown);
+    SitesCopy.Reserve(Shown.Num());
+    for (const int32 j : Shown) SitesCopy.Add(Sites[j]);
 
     FTimerDelegate Del;
-    Del.BindLambda([this, SitesCopy]()
+    Del.BindWeakLambda(this, [this, SitesCopy]()
     {
-        UWorld* W = GetWorld();
-        if (!W) return;
+        UTabletopFXPoolSubsystem* FXPool = UTabletopFXPoolSubsystem::Get(this);
+        if (!FXPool) return;
 
         if (SitesCopy.Num() == 0)
         {
             // Fallback: single center impact at attacker forward a bit (or skip)
             const FVector FallbackLoc = GetActorLocation() + GetActorForwardVector()*100.f + FVector(0,0,50.f);
-            if (FX_Impact) UNiagaraFunctionLibrary::SpawnSystemAtLocation(W, FX_Impact, FallbackLoc, GetActorRotation());
-            if (Snd_Impact) UGameplayStatics::PlaySoundAtLocation(this, Snd_Impact, FallbackLoc, 1.f, 1.f, 0.f, SndAttenuation, SndConcurrency);
+            if (FX_Impact) FXPool->SpawnOneShot(FX_Impact, FallbackLoc, GetActorRotation());
+            if (Snd_Impact) FXPool->PlayOneShotSound(Snd_Impact, FallbackLoc, SndAttenuation, SndConcurrency);
             return;
         }
 
         for (const FImpactSite& S : SitesCopy)
         {
-            if (FX_Impact) UNiagaraFunctionLibrary::SpawnSystemAtLocation(W, FX_Impact, S.Loc, S.Rot);
-            if (Snd_Impact) UGameplayStatics::PlaySoundAtLocation(this, Snd_Impact, S.Loc, 1.f, 1.f, 0.f, SndAttenuation, SndConcurrency);
+            if (FX_Impact) FXPool->SpawnOneShot(FX_Impact, S.Loc, S.Rot);
+            if (Snd_Impact) FXPool->PlayOneShotSound(Snd_Impact, S.Loc, SndAttenuation, SndConcurrency);
         }
     });
 
@@ -690,11 +814,8 @@ int32 AUnitBase::FindBestShooterModelIndex(const FVector& TargetWorld) const
     int32 BestIdx = INDEX_NONE;
     float BestD2  = TNumericLimits<float>::Max();
 
-    for (int32 i = 0; i < ModelMeshes.Num(); ++i)
+    for (int32 i = 0; i < GetNumModelVisuals(); ++i)
     {
-        UStaticMeshComponent* C = ModelMeshes[i];
-        if (!IsValid(C)) continue;
-
         const FVector MuzzleLoc = GetMuzzleTransform(i).GetLocation();
         const float D2 = FVector::DistSquaredXY(MuzzleLoc, TargetWorld);
         if (D2 < BestD2)
@@ -708,27 +829,27 @@ int32 AUnitBase::FindBestShooterModelIndex(const FVector& TargetWorld) const
 
 void AUnitBase::OnRep_VFXAudio()
 {
+    // Fires once per replicated FX property; Prewarm is a no-op once the asset has enough pooled
+    if (UTabletopFXPoolSubsystem* Pool = UTabletopFXPoolSubsystem::Get(this))
+    {
+        Pool->Prewarm(FX_Muzzle, FXPrewarmMuzzle);
+        Pool->Prewarm(FX_Impact, FXPrewarmImpact);
+    }
 }
 
 void AUnitBase::PlayImpactFXAndSounds_Delayed(AUnitBase* TargetUnit)
 {
     if (!IsValid(TargetUnit)) return;
 
-    for (int32 j = 0; j < TargetUnit->ModelMeshes.Num(); ++j)
-    {
-        UStaticMeshComponent* TC = TargetUnit->ModelMeshes[j];
-        if (!IsValid(TC)) continue;
+    UTabletopFXPoolSubsystem* Pool = UTabletopFXPoolSubsystem::Get(this);
+    if (!Pool) return;
 
+    TArray<int32> Shown;
+    UTabletopFXPoolSubsystem::PickRepresentatives(TargetUnit->GetNumModelVisuals(), FXVolleyAggregateAbove, FXVolleyRepresentatives, Shown);
+    for (const int32 j : Shown)
+    {
         // Compute the exact impact location per target model
-        FVector ImpactLoc;
-        if (TC->DoesSocketExist(TargetUnit->ImpactSocketName))
-        {
-            ImpactLoc = TC->GetSocketTransform(TargetUnit->ImpactSocketName, ERelativeTransformSpace::RTS_World).GetLocation();
-        }
-        else
-        {
-            ImpactLoc = TC->GetComponentTransform().TransformPosition(TargetUnit->ImpactOffsetLocal);
-        }
+        const FVector ImpactLoc = TargetUnit->GetModelImpactPoint(j);
 
         // Find the shooter muzzle closest to THIS impact point
         const int32 BestShooterIdx = FindBestShooterModelIndex(ImpactLoc);
@@ -739,12 +860,12 @@ void AUnitBase::PlayImpactFXAndSounds_Delayed(AUnitBase* TargetUnit)
 
         if (FX_Impact)
         {
-            UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), FX_Impact, ImpactLoc, IncomingRot);
+            Pool->SpawnOneShot(FX_Impact, ImpactLoc, IncomingRot);
         }
 
         if (Snd_Impact)
         {
-            UGameplayStatics::PlaySoundAtLocation(this, Snd_Impact, ImpactLoc, 1.f, 1.f, 0.f, SndAttenuation, SndConcurrency);
+            Pool->PlayOneShotSound(Snd_Impact, ImpactLoc, SndAttenuation, SndConcurrency);
         }
     }
 }
@@ -752,8 +873,9 @@ void AUnitBase::PlayImpactFXAndSounds_Delayed(AUnitBase* TargetUnit)
 void AUnitBase::GetModelWorldLocations(TArray<FVector>& Out) const
 {
     Out.Reset();
-    for (UStaticMeshComponent* C : ModelMeshes)
-        if (IsValid(C)) Out.Add(C->GetComponentLocation());
+    Out.Reserve(GetNumModelVisuals());
+    for (int32 i = 0; i < GetNumModelVisuals(); ++i)
+        Out.Add(GetModelWorldTransform(i).GetLocation());
 
     if (Out.Num() == 0) Out.Add(GetActorLocation());
 }
@@ -808,6 +930,7 @@ void AUnitBase::ApplyDamage_Server(int32 Damage)
         ModelsCurrent = NewModels;
         RebuildFormation();
     }
+    PackHealthState();
 
     // fire-and-forget audio/FX to everyone
     if (ModelsLost > 0)
@@ -847,118 +970,391 @@ void AUnitBase::Multicast_OnDamaged_Implementation(int32 ModelsLost, int32 Wound
     }
 }
 
-void AUnitBase::OnRep_Health()
+void AUnitBase::OnRep_HealthState()
 {
-    const int32 PerModel = FMath::Max(1, WoundsRep);
-    int32 NewModels = (WoundsPool + PerModel - 1) / PerModel;
-    NewModels = FMath::Clamp(NewModels, 0, ModelsMax);
+    WoundsPool    = HealthRep.WoundsPool;
+    ModelsCurrent = HealthRep.ModelsCurrent;
+    RebuildFormation();
+    EnsureRuntimeBuilt();
+}
 
-    if (NewModels != ModelsCurrent)
+void AUnitBase::OnRep_StatSnapshot()
+{
+    ToughnessRep        = StatSnapshot.Toughness;
+    WoundsRep           = StatSnapshot.Wounds;
+    SaveRep             = StatSnapshot.Save;
+    InvulnerableSaveRep = StatSnapshot.InvulnSave;
+    FeelNoPainRep       = StatSnapshot.FeelNoPain;
+    ModelsMax           = StatSnapshot.ModelsMax;
+    ObjectiveControlPerModel = StatSnapshot.ObjectiveControlPerModel;
+}
+
+void AUnitBase::PackStatSnapshot()
+{
+    TABLETOP_MARK_DIRTY(AUnitBase, StatSnapshot, this);
+    StatSnapshot.Toughness  = (uint8)FMath::Clamp(ToughnessRep, 0, 31);
+    StatSnapshot.Wounds     = (uint8)FMath::Clamp(WoundsRep, 0, 63);
+    StatSnapshot.Save       = (uint8)FMath::Clamp(SaveRep, 0, 7);
+    StatSnapshot.InvulnSave = (uint8)FMath::Clamp(InvulnerableSaveRep, 0, 7);
+    StatSnapshot.FeelNoPain = (uint8)FMath::Clamp(FeelNoPainRep, 0, 7);
+    StatSnapshot.ModelsMax  = (uint8)FMath::Clamp(ModelsMax, 0, 127);
+    StatSnapshot.ObjectiveControlPerModel = (uint8)FMath::Clamp(ObjectiveControlPerModel, 0, 31);
+
+#if !(UE_BUILD_SHIPPING)
+    if (StatSnapshot.Toughness != ToughnessRep || StatSnapshot.Wounds != WoundsRep || StatSnapshot.ModelsMax != ModelsMax
+        || StatSnapshot.ObjectiveControlPerModel != ObjectiveControlPerModel)
     {
-        ModelsCurrent = NewModels;
+        UE_LOG(LogTabletop, Warning, TEXT("[Unit] %s stats out of snapshot range (T%d W%d x%d OC%d); clients will see clamped values"),
+            *UnitId.ToString(), ToughnessRep, WoundsRep, ModelsMax, ObjectiveControlPerModel);
     }
-    RebuildFormation();
+#endif
+}
+
+void AUnitBase::PackHealthState()
+{
+    static_assert(127 * 63 <= FUnitHealthState::WoundsPoolMax, "WoundsPool must hold ModelsMax x Wounds");
+    ensureMsgf(WoundsPool <= (int32)FUnitHealthState::WoundsPoolMax, TEXT("%s WoundsPool %d doesn't fit the health snapshot"), *UnitId.ToString(), WoundsPool);
+    HealthRep.WoundsPool    = (uint16)FMath::Clamp(WoundsPool, 0, (int32)FUnitHealthState::WoundsPoolMax);
+    HealthRep.ModelsCurrent = (uint8)FMath::Clamp(ModelsCurrent, 0, 127);
+    TABLETOP_MARK_DIRTY(AUnitBase, HealthRep, this);
+}
+
+// ---- push-model dirties ----
+
+void AUnitBase::MarkTurnStateDirty()
+{
+    TABLETOP_MARK_DIRTY(AUnitBase, MoveBudgetInches, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, MoveMaxInches, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, bHasShot, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, bMovedThisTurn, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, bAdvancedThisTurn, this);
+}
+
+void AUnitBase::MarkOverwatchDirty()
+{
+    TABLETOP_MARK_DIRTY(AUnitBase, bOverwatchArmed, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, bOverwatchVisibleToEnemies, this);
+}
+
+void AUnitBase::MarkAPDebtDirty()
+{
+    TABLETOP_MARK_DIRTY(AUnitBase, NextPhaseAPDebt, this);
+}
+
+void AUnitBase::MarkInitStateDirty()
+{
+    TABLETOP_MARK_DIRTY(AUnitBase, UnitId, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, UnitName, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, Faction, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, OwningPS, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, WeaponIndex, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, CurrentWeapon, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, AbilityClassesRep, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, ModelMesh, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, FX_Muzzle, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, FX_Impact, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, Snd_Muzzle, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, Snd_Impact, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, Snd_Selected, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, Snd_UnderFire, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, SndAttenuation, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, SndConcurrency, this);
+    TABLETOP_MARK_DIRTY(AUnitBase, ImpactDelaySeconds, this);
+    MarkTurnStateDirty();
+    MarkOverwatchDirty();
+}
+
+// ---- packed net structs ----
+
+// Fixed-width field; values above the width saturate
+static void SerializePacked(FArchive& Ar, uint8& Value, uint32 NumBits)
+{
+    const uint32 MaxV = (1u << NumBits) - 1;
+    uint32 Tmp = Ar.IsSaving() ? FMath::Min<uint32>(Value, MaxV) : 0;
+    Ar.SerializeBits(&Tmp, NumBits);
+    if (Ar.IsLoading()) Value = (uint8)(Tmp & MaxV);
+}
+
+bool FUnitStatSnapshot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    SerializePacked(Ar, Toughness,  5);
+    SerializePacked(Ar, Wounds,     6);
+    SerializePacked(Ar, Save,       3);
+    SerializePacked(Ar, InvulnSave, 3);
+    SerializePacked(Ar, FeelNoPain, 3);
+    SerializePacked(Ar, ModelsMax,  7);
+    SerializePacked(Ar, ObjectiveControlPerModel, 5);
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
+
+bool FUnitHealthState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    uint32 Pool = Ar.IsSaving() ? FMath::Min<uint32>(WoundsPool, WoundsPoolMax) : 0;
+    Ar.SerializeBits(&Pool, WoundsPoolBits);
+    if (Ar.IsLoading()) WoundsPool = (uint16)(Pool & WoundsPoolMax);
+
+    SerializePacked(Ar, ModelsCurrent, 7);
+    bOutSuccess = !Ar.IsError();
+    return true;
 }
 
 void AUnitBase::AddUnitModifier(const FUnitModifier& Mod)
 {
-    ActiveCombatMods.Add(Mod);
+    FActiveCombatModItem& Item = ActiveCombatMods.Items.AddDefaulted_GetRef();
+    Item.Mod = Mod;
+    ActiveCombatMods.MarkItemDirty(Item);
+    IndexModAt(ActiveCombatMods.Num() - 1);
+    OnCombatModChanged.Broadcast(ECombatModChange::Added, Mod);
 }
 
-static bool MatchesRole(const FUnitModifier& M, bool bAsAttacker)
+TArray<FUnitModifier> AUnitBase::GetActiveCombatMods() const
 {
-    if (M.Targeting == EModifierTarget::OwnerAlways)        return true;
-    if (M.Targeting == EModifierTarget::OwnerWhenAttacking) return bAsAttacker;
-    if (M.Targeting == EModifierTarget::OwnerWhenDefending) return !bAsAttacker;
-    return false;
+    TArray<FUnitModifier> Out;
+    Out.Reserve(ActiveCombatMods.Num());
+    for (const FActiveCombatModItem& It : ActiveCombatMods.Items) Out.Add(It.Mod);
+    return Out;
+}
+
+// ---- fast array callbacks (clients) ----
+
+void FActiveCombatModItem::PreReplicatedRemove(const FActiveCombatModArray& InArray)
+{
+    if (InArray.Owner) InArray.Owner->QueueCombatModEvent(ECombatModChange::Removed, Mod);
+}
+
+void FActiveCombatModItem::PostReplicatedAdd(const FActiveCombatModArray& InArray)
+{
+    if (InArray.Owner) InArray.Owner->QueueCombatModEvent(ECombatModChange::Added, Mod);
+}
+
+void FActiveCombatModItem::PostReplicatedChange(const FActiveCombatModArray& InArray)
+{
+    if (InArray.Owner) InArray.Owner->QueueCombatModEvent(ECombatModChange::Changed, Mod);
+}
+
+void FActiveCombatModArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+    if (Owner) Owner->OnCombatModsReceived();
+}
+
+void AUnitBase::QueueCombatModEvent(ECombatModChange Change, const FUnitModifier& Mod)
+{
+    PendingCombatModEvents.Emplace(Change, Mod);
+}
+
+void AUnitBase::OnCombatModsReceived()
+{
+    // Removes shuffle the array, so reindex before any listener can query stage mods
+    RebuildModIndex();
+
+    TArray<TPair<ECombatModChange, FUnitModifier>> Events = MoveTemp(PendingCombatModEvents);
+    PendingCombatModEvents.Reset();
+    for (const TPair<ECombatModChange, FUnitModifier>& E : Events)
+    {
+        OnCombatModChanged.Broadcast(E.Key, E.Value);
+    }
+}
+
+void AUnitBase::MarkCombatModChanged(FActiveCombatModItem& Item)
+{
+    ActiveCombatMods.MarkItemDirty(Item);
+    OnCombatModChanged.Broadcast(ECombatModChange::Changed, Item.Mod);
+}
+
+static uint16 ModStageKey(ECombatEvent Stage, EModifierTarget Targeting)
+{
+    return (uint16(Stage) << 8) | uint16(Targeting);
+}
+
+static EModifierTarget RoleTargeting(bool bAsAttacker)
+{
+    return bAsAttacker ? EModifierTarget::OwnerWhenAttacking : EModifierTarget::OwnerWhenDefending;
+}
+
+void AUnitBase::IndexModAt(int32 Idx)
+{
+    const FUnitModifier& M = ActiveCombatMods.Items[Idx].Mod;
+    ModsByStage.FindOrAdd(ModStageKey(M.AppliesAt, M.Targeting)).Add(Idx);
+    ModsByExpiry[(int32)M.Expiry].Add(Idx);
+}
+
+void AUnitBase::RemoveModAt(int32 Idx)
+{
+    const int32 Last = ActiveCombatMods.Num() - 1;
+
+    const FUnitModifier& Gone = ActiveCombatMods.Items[Idx].Mod;
+    if (FModIndexBucket* B = ModsByStage.Find(ModStageKey(Gone.AppliesAt, Gone.Targeting)))
+    {
+        B->RemoveSingleSwap(Idx);
+    }
+    ModsByExpiry[(int32)Gone.Expiry].RemoveSingleSwap(Idx);
+
+    // RemoveAtSwap moves the last mod into Idx; point its entries at the new slot
+    if (Idx != Last)
+    {
+        const FUnitModifier& Moved = ActiveCombatMods.Items[Last].Mod;
+        if (FModIndexBucket* B = ModsByStage.Find(ModStageKey(Moved.AppliesAt, Moved.Targeting)))
+        {
+            if (int32* Slot = B->FindByKey(Last)) *Slot = Idx;
+        }
+        if (int32* Slot = ModsByExpiry[(int32)Moved.Expiry].FindByKey(Last)) *Slot = Idx;
+    }
+
+    const FUnitModifier Removed = Gone; // Gone dangles after the swap
+    ActiveCombatMods.Items.RemoveAtSwap(Idx);
+    ActiveCombatMods.MarkArrayDirty();
+    OnCombatModChanged.Broadcast(ECombatModChange::Removed, Removed);
+}
+
+void AUnitBase::RebuildModIndex()
+{
+    ModsByStage.Reset();
+    for (FModIndexBucket& B : ModsByExpiry) B.Reset();
+
+    for (int32 i = 0; i < ActiveCombatMods.Num(); ++i)
+    {
+        IndexModAt(i);
+    }
 }
 
 FRollModifiers AUnitBase::CollectStageMods(ECombatEvent Stage, bool bAsAttacker, const AUnitBase* /*Opp*/) const
 {
     FRollModifiers Out;
-    for (const FUnitModifier& M : ActiveCombatMods)
+    for (const EModifierTarget T : { RoleTargeting(bAsAttacker), EModifierTarget::OwnerAlways })
     {
-        if (M.AppliesAt != Stage) continue;
-        if (!MatchesRole(M, bAsAttacker)) continue;
-
-        Out.Accumulate(M.Mods);
+        if (const FModIndexBucket* B = ModsByStage.Find(ModStageKey(Stage, T)))
+        {
+            for (const int32 Idx : *B)
+            {
+                Out.Accumulate(ActiveCombatMods.Items[Idx].Mod.Mods);
+            }
+        }
     }
     return Out;
 }
 
+// Indices from the given buckets, highest first, so RemoveModAt never moves a mod we still have to visit
+static void GatherDescending(AUnitBase::FModIndexBucket& Out, const AUnitBase::FModIndexBucket* A, const AUnitBase::FModIndexBucket* B = nullptr)
+{
+    Out.Reset();
+    if (A) Out.Append(*A);
+    if (B) Out.Append(*B);
+    Out.Sort(TGreater<int32>());
+}
+
 void AUnitBase::ConsumeForStage(ECombatEvent Stage, bool bAsAttacker)
 {
-    for (int32 i = ActiveCombatMods.Num()-1; i >= 0; --i)
+    FModIndexBucket Candidates;
+    GatherDescending(Candidates,
+        ModsByStage.Find(ModStageKey(Stage, RoleTargeting(bAsAttacker))),
+        ModsByStage.Find(ModStageKey(Stage, EModifierTarget::OwnerAlways)));
+
+    for (const int32 i : Candidates)
     {
-        FUnitModifier& M = ActiveCombatMods[i];
-        if (M.AppliesAt != Stage || !MatchesRole(M, bAsAttacker)) continue;
+        FActiveCombatModItem& Item = ActiveCombatMods.Items[i];
+        FUnitModifier& M = Item.Mod;
 
         if (M.Expiry == EModifierExpiry::NextNOwnerShots && bAsAttacker)
         {
             if (M.UsesRemaining > 0 && --M.UsesRemaining == 0)
             {
-                ActiveCombatMods.RemoveAtSwap(i);
+                RemoveModAt(i);
                 if (AMatchGameMode* GM = GetWorld()->GetAuthGameMode<AMatchGameMode>())
                 {
                     if (!HasAuthority()) return;
                     GM->Emit(ECombatEvent::Ability_Expired, this);
                 }
             }
+            else
+            {
+                MarkCombatModChanged(Item);
+            }
         }
         else if (M.Expiry == EModifierExpiry::Uses)
         {
             if (M.UsesRemaining > 0 && --M.UsesRemaining == 0)
             {
-                ActiveCombatMods.RemoveAtSwap(i);
+                RemoveModAt(i);
                 if (AMatchGameMode* GM = GetWorld()->GetAuthGameMode<AMatchGameMode>())
                 {
                     if (!HasAuthority()) return;
                     GM->Emit(ECombatEvent::Ability_Expired, this);
                 }
             }
+            else
+            {
+                MarkCombatModChanged(Item);
+            }
         }
     }
 }
 
 void AUnitBase::OnTurnAdvanced()
 {
-    for (int32 i = ActiveCombatMods.Num()-1; i >= 0; --i)
+    FModIndexBucket Candidates;
+    GatherDescending(Candidates, &ModsByExpiry[(int32)EModifierExpiry::UntilEndOfTurn]);
+
+    for (const int32 i : Candidates)
     {
-        FUnitModifier& M = ActiveCombatMods[i];
-        if (M.Expiry == EModifierExpiry::UntilEndOfTurn && --M.TurnsRemaining <= 0)
+        FActiveCombatModItem& Item = ActiveCombatMods.Items[i];
+        if (--Item.Mod.TurnsRemaining <= 0)
         {
-            ActiveCombatMods.RemoveAtSwap(i);
+            RemoveModAt(i);
             if (AMatchGameMode* GM = GetWorld()->GetAuthGameMode<AMatchGameMode>())
             {
                 if (!HasAuthority()) return;
                 GM->Emit(ECombatEvent::Ability_Expired, this);
             }
         }
+        else
+        {
+            MarkCombatModChanged(Item);
+        }
     }
 }
 
 void AUnitBase::OnRoundAdvanced()
 {
-    for (int32 i = ActiveCombatMods.Num()-1; i >= 0; --i)
+    FModIndexBucket Candidates;
+    GatherDescending(Candidates, &ModsByExpiry[(int32)EModifierExpiry::UntilEndOfRound]);
+
+    for (const int32 i : Candidates)
     {
-        FUnitModifier& M = ActiveCombatMods[i];
-        if (M.Expiry == EModifierExpiry::UntilEndOfRound && --M.TurnsRemaining <= 0)
+        FActiveCombatModItem& Item = ActiveCombatMods.Items[i];
+        if (--Item.Mod.TurnsRemaining <= 0)
         {
-            ActiveCombatMods.RemoveAtSwap(i);
+            RemoveModAt(i);
             if (AMatchGameMode* GM = GetWorld()->GetAuthGameMode<AMatchGameMode>())
             {
                 if (!HasAuthority()) return;
                 GM->Emit(ECombatEvent::Ability_Expired, this);
             }
         }
+        else
+        {
+            MarkCombatModChanged(Item);
+        }
     }
 }
 void AUnitBase::ApplyOutlineToAllModels(UMaterialInterface* Mat)
 {
-    for (UStaticMeshComponent* C : ModelMeshes)
+    // One component for every model now, so this is a single overlay swap
+    if (ModelInstances && ModelInstances->GetOverlayMaterial() != Mat)
     {
-        if (!IsValid(C)) continue;
-        C->SetOverlayMaterial(Mat);
+        ModelInstances->SetOverlayMaterial(Mat);
+    }
+}
+
+void AUnitBase::ApplyHighlightCustomData(int32 FirstInstance)
+{
+    if (!ModelInstances) return;
+
+    const float Value = (float)(uint8)CurrentHighlight;
+    const int32 Num = ModelInstances->GetInstanceCount();
+    for (int32 i = FMath::Max(0, FirstInstance); i < Num; ++i)
+    {
+        ModelInstances->SetCustomDataValue(i, 0, Value, /*bMarkRenderStateDirty=*/ i == Num - 1);
     }
 }
 
@@ -967,6 +1363,15 @@ void AUnitBase::SetHighlightLocal(EUnitHighlight Mode)
     if (CurrentHighlight == Mode) return;
     CurrentHighlight = Mode;
 
+    ApplyHighlightCustomData();
+
+    if (OutlineInstancedMaterial)
+    {
+        // Shared overlay picks its colour from the per-instance data
+        ApplyOutlineToAllModels(OutlineInstancedMaterial);
+        return;
+    }
+
     switch (Mode)
     {
     case EUnitHighlight::Friendly:       ApplyOutlineToAllModels(OutlineFriendlyMaterial);        break;
@@ -1014,6 +1419,7 @@ void AUnitBase::ApplyHealing_Server_Implementation(int32 Wounds)
         ModelsCurrent = NewModels;
         RebuildFormation();
     }
+    PackHealthState();
 
     // Cosmetic-only multicast if you want (do NOT mutate state in multicast)
     // Multicast_OnHealed( /*...amount...*/ );
@@ -1021,14 +1427,9 @@ void AUnitBase::ApplyHealing_Server_Implementation(int32 Wounds)
     ForceNetUpdate();
 }
 
-void AUnitBase::OnRep_Models()
-{
-    RebuildFormation();
-    EnsureRuntimeBuilt();
-}
-
 void AUnitBase::OnRep_Move()
 {
+    BumpTransformVersion();
     OnMoveChanged.Broadcast();
     EnsureRuntimeBuilt();
     RefreshRangeIfActive();
@@ -1053,18 +1454,17 @@ void AUnitBase::NotifyMoveChanged()
 
 void AUnitBase::ApplyFormationOffsetsLocal(const TArray<FVector>& OffsetsLocal)
 {
-    // Ensure the right number of components exist locally on each client
+    // Ensure the right number of instances exist locally on each client
     RebuildFormation();
 
-    const int32 N = FMath::Min(ModelMeshes.Num(), OffsetsLocal.Num());
+    const int32 N = FMath::Min(ModelLocalXforms.Num(), OffsetsLocal.Num());
     for (int32 i = 0; i < N; ++i)
     {
-        if (UStaticMeshComponent* C = ModelMeshes[i])
-        {
-            const FVector P = OffsetsLocal[i];
-            C->SetRelativeLocation(FVector(P.X, P.Y, 0.f));
-        }
+        const FVector P = OffsetsLocal[i];
+        ModelLocalXforms[i].SetLocation(FVector(P.X, P.Y, 0.f));
     }
+    PushModelTransforms();
+    BumpTransformVersion();
 }
 
 void AUnitBase::RebuildRuntimeAbilitiesFromSources()
@@ -1124,38 +1524,42 @@ void AUnitBase::RebuildRuntimeActions()
 
 void AUnitBase::RebuildFormation()
 {
+    if (!ModelInstances) return;
+
     const int32 Needed = FMath::Max(0, ModelsCurrent);
 
-    // Remove extras
-    for (int32 i = ModelMeshes.Num() - 1; i >= Needed; --i)
+    if (ModelInstances->GetStaticMesh() != ModelMesh)
     {
-        if (UStaticMeshComponent* C = ModelMeshes[i]) { C->DestroyComponent(); }
-        ModelMeshes.RemoveAt(i);
+        ModelInstances->SetStaticMesh(ModelMesh);
     }
-
-    // Add missing
-    while (ModelMeshes.Num() < Needed)
+    if (CachedSocketMesh.Get() != ModelMesh)
     {
-        const FName CompName = *FString::Printf(TEXT("Model_%02d"), ModelMeshes.Num());
-        UStaticMeshComponent* C = NewObject<UStaticMeshComponent>(this, CompName);
-        C->SetupAttachment(RootComponent);
-        C->RegisterComponent();
-        C->SetCanEverAffectNavigation(false);
-        C->SetMobility(EComponentMobility::Movable);
-        if (ModelMesh) C->SetStaticMesh(ModelMesh);
-        C->SetRenderCustomDepth(false);
-        C->SetRelativeScale3D(FVector(ModelScale));
+        CacheModelSockets();
+    }
+    ModelInstances->SetCollisionResponseToChannel(SelectionTraceECC, ECR_Block);
 
-        C->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-        C->SetGenerateOverlapEvents(false);
-        C->SetCollisionResponseToAllChannels(ECR_Ignore);
-        C->SetCollisionResponseToChannel(SelectionTraceECC, ECR_Block);
-        C->SetCollisionResponseToChannel(ECC_GameTraceChannel5 /*LOS*/, ECR_Ignore);
+    // Remove extras (always from the back so nothing else gets reindexed)
+    const int32 Had = ModelLocalXforms.Num();
+    for (int32 i = Had - 1; i >= Needed; --i)
+    {
+        ModelInstances->RemoveInstance(i);
+    }
+    ModelLocalXforms.SetNum(FMath::Min(Had, Needed));
 
-        ModelMeshes.Add(C);
+    // Add missing
+    if (ModelLocalXforms.Num() < Needed)
+    {
+        const int32 First = ModelLocalXforms.Num();
+        ModelLocalXforms.SetNum(Needed);
+        for (int32 i = First; i < Needed; ++i)
+        {
+            ModelLocalXforms[i] = FTransform(FRotator(0.f, ModelYawVisualOffsetDeg, 0.f), FVector::ZeroVector, FVector(ModelScale));
+        }
+        ModelInstances->AddInstances(TArray<FTransform>(ModelLocalXforms.GetData() + First, Needed - First), /*bShouldReturnIndices=*/false);
+        ApplyHighlightCustomData(First);
     }
 
-    if (ModelMeshes.Num() == 0) return;
+    if (ModelLocalXforms.Num() == 0) return;
 
     const int32 N = FMath::Max(1, ModelsCurrent);
 
@@ -1204,51 +1608,52 @@ void AUnitBase::RebuildFormation()
     for (const auto& p : points) centroid += p;
     centroid /= float(points.Num());
 
-    for (int32 i = 0; i < ModelMeshes.Num(); ++i)
+    for (int32 i = 0; i < ModelLocalXforms.Num(); ++i)
     {
-        if (UStaticMeshComponent* C = ModelMeshes[i])
-        {
-            const FVector2D p = points[i] - centroid;
-            C->SetRelativeLocation(FVector(p.X, p.Y, 0.f));
-            C->SetRelativeRotation(FRotator(0.f, ModelYawVisualOffsetDeg, 0.f));
-            C->SetRelativeScale3D(FVector(ModelScale));
-        }
+        const FVector2D p = points[i] - centroid;
+        ModelLocalXforms[i] = FTransform(FRotator(0.f, ModelYawVisualOffsetDeg, 0.f), FVector(p.X, p.Y, 0.f), FVector(ModelScale));
     }
+    PushModelTransforms();
+    BumpTransformVersion();
+}
+
+void AUnitBase::PushModelTransforms()
+{
+    if (!ModelInstances || ModelLocalXforms.Num() == 0) return;
+
+    // Instances are relative to ModelInstances, which sits on the root with identity
+    ModelInstances->BatchUpdateInstancesTransforms(0, ModelLocalXforms, /*bWorldSpace=*/false, /*bMarkRenderStateDirty=*/true, /*bTeleport=*/true);
 }
 
 void AUnitBase::VisualFaceYaw(float WorldYaw)
 {
     const float LocalYaw = WorldYaw - GetActorRotation().Yaw;
 
-    for (UStaticMeshComponent* C : ModelMeshes)
+    const FQuat Q = FRotator(0.f, LocalYaw + ModelYawVisualOffsetDeg, 0.f).Quaternion();
+    for (FTransform& T : ModelLocalXforms)
     {
-        if (!C) continue;
-        C->SetRelativeRotation(FRotator(0.f, LocalYaw + ModelYawVisualOffsetDeg, 0.f));
+        T.SetRotation(Q);
     }
+    PushModelTransforms();
+    BumpTransformVersion(); // muzzle/impact sockets turned with the models
 }
 
 AActor* AUnitBase::FindNearestEnemyUnit(float MaxSearchDistCm) const
 {
-    AUnitBase* Best = nullptr;
-    float BestSq = MaxSearchDistCm * MaxSearchDistCm;
-    const FVector MyLoc = GetActorLocation();
+    const UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(this);
+    if (!Index) return nullptr;
 
-    for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
-    {
-        AUnitBase* U = *It;
-        if (!U || U == this || !U->IsActorInitialized()) continue;
-        if (!IsEnemy(U)) continue;
-
-        const float D2 = FVector::DistSquared(MyLoc, U->GetActorLocation());
-        if (D2 < BestSq) { BestSq = D2; Best = U; }
-    }
-    return Best;
+    FUnitSpatialFilter F;
+    F.EnemiesOf  = this;
+    F.bAliveOnly = false; // old scan didn't care; dead units are destroyed right away anyway
+    return Index->FindNearest(GetActorLocation(), MaxSearchDistCm, F);
 }
 
 bool AUnitBase::FaceActorInstant(AActor* Target, float YawSnapDeg)
 {
     if (!Target) return false;
     CurrentTarget = Target;
+    TABLETOP_MARK_DIRTY(AUnitBase, CurrentTarget, this);
     ForceNetUpdate();
     FVector Dir = Target->GetActorLocation() - GetActorLocation();
     Dir.Z = 0.f;
@@ -1259,12 +1664,20 @@ bool AUnitBase::FaceActorInstant(AActor* Target, float YawSnapDeg)
     if (DeltaYaw < YawSnapDeg) return false;
 
     SetActorRotation(FRotator(0.f, Desired.Yaw + FacingYawOffsetDeg, 0.f));
+    BumpTransformVersion();
     return true;
 }
 
+AUnitBase* AUnitBase::RefreshNearestEnemyCache()
+{
+    AUnitBase* Enemy = Cast<AUnitBase>(FindNearestEnemyUnit());
+    SetCachedNearestEnemy(Enemy, Enemy ? FVector::DistSquared(GetActorLocation(), Enemy->GetActorLocation()) : 0.f);
+    return Enemy;
+}
+
 void AUnitBase::FaceNearestEnemyInstant()
 {
-    if (AActor* Enemy = FindNearestEnemyUnit())
+    if (AActor* Enemy = RefreshNearestEnemyCache())
     {
         FaceActorInstant(Enemy);
     }
@@ -1292,19 +1705,15 @@ bool AUnitBase::IsEnemy(const AUnitBase* Other) const
 
 void AUnitBase::OnRep_ModelVisual()
 {
-    // If components already exist, apply the new mesh to them
-    bool bApplied = false;
-    for (UStaticMeshComponent* C : ModelMeshes)
+    // Swapping the mesh on the instanced component keeps every instance; sockets need re-reading though
+    if (ModelInstances)
     {
-        if (IsValid(C))
-        {
-            C->SetStaticMesh(ModelMesh);
-            bApplied = true;
-        }
+        ModelInstances->SetStaticMesh(ModelMesh);
     }
+    CacheModelSockets();
 
-    // If we didn’t have components yet (or count changed), rebuild now
-    if (!bApplied || ModelMeshes.Num() != FMath::Max(0, ModelsCurrent))
+    // If we didn’t have instances yet (or count changed), rebuild now
+    if (ModelLocalXforms.Num() == 0 || ModelLocalXforms.Num() != FMath::Max(0, ModelsCurrent))
     {
         RebuildFormation();
     }
@@ -1314,55 +1723,48 @@ void AUnitBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetim
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(AUnitBase, UnitId);
-    DOREPLIFETIME(AUnitBase, UnitName);
-    DOREPLIFETIME(AUnitBase, Faction);
-    DOREPLIFETIME(AUnitBase, OwningPS);
-    DOREPLIFETIME(AUnitBase, WeaponIndex);
-    DOREPLIFETIME(AUnitBase, CurrentTarget);
+    FDoRepLifetimeParams Push;
+    Push.bIsPushBased = true;
+
+    // Fixed by Server_InitFromRow, which runs in the spawn frame
+    FDoRepLifetimeParams PushInitial = Push;
+    PushInitial.Condition = COND_InitialOnly;
 
-    DOREPLIFETIME(AUnitBase, ModelsCurrent);
-    DOREPLIFETIME(AUnitBase, ModelsMax);
-    DOREPLIFETIME(AUnitBase, ModelMesh);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, UnitId,            PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, UnitName,          PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, Faction,           PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, WeaponIndex,       PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, StatSnapshot,      PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, CurrentWeapon,     PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, AbilityClassesRep, PushInitial);
 
-    DOREPLIFETIME(AUnitBase, MoveBudgetInches);
-    DOREPLIFETIME(AUnitBase, MoveMaxInches);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, OwningPS,      Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, CurrentTarget, Push);
 
-    DOREPLIFETIME(AUnitBase, bHasShot);
-    DOREPLIFETIME(AUnitBase, ToughnessRep);
-    DOREPLIFETIME(AUnitBase, WoundsRep);
-    DOREPLIFETIME(AUnitBase, ObjectiveControlPerModel);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, HealthRep, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, ModelMesh, Push);
 
-    DOREPLIFETIME(AUnitBase, WeaponRangeInchesRep);
-    DOREPLIFETIME(AUnitBase, WeaponAttacksRep);
-    DOREPLIFETIME(AUnitBase, WeaponDamageRep);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, MoveBudgetInches, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, MoveMaxInches,    Push);
 
-    DOREPLIFETIME(AUnitBase, SaveRep);
-    DOREPLIFETIME(AUnitBase, WeaponSkillToHitRep);
-    DOREPLIFETIME(AUnitBase, WeaponStrengthRep);
-    DOREPLIFETIME(AUnitBase, WeaponAPRep);
-    DOREPLIFETIME(AUnitBase, WoundsPool);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, bHasShot, Push);
 
+    // Fast array: already delta-serialized per item, left out of push model
     DOREPLIFETIME(AUnitBase, ActiveCombatMods);
-    DOREPLIFETIME(AUnitBase, bMovedThisTurn);
-    DOREPLIFETIME(AUnitBase, bAdvancedThisTurn);
-
-    DOREPLIFETIME(AUnitBase, CurrentWeapon);
-    DOREPLIFETIME(AUnitBase, InvulnerableSaveRep);
-    DOREPLIFETIME(AUnitBase, FeelNoPainRep);
-
-    DOREPLIFETIME(AUnitBase, AbilityClassesRep);
-    DOREPLIFETIME(AUnitBase, NextPhaseAPDebt);
-    DOREPLIFETIME(AUnitBase, bOverwatchArmed);
-    DOREPLIFETIME(AUnitBase, bOverwatchVisibleToEnemies);
-
-    DOREPLIFETIME_CONDITION(AUnitBase, FX_Muzzle,           COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, FX_Impact,           COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, Snd_Muzzle,          COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, Snd_Impact,          COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, Snd_Selected,        COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, Snd_UnderFire,       COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, SndAttenuation,           COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, SndConcurrency,            COND_InitialOnly);
-    DOREPLIFETIME_CONDITION(AUnitBase, ImpactDelaySeconds,  COND_InitialOnly);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, bMovedThisTurn,    Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, bAdvancedThisTurn, Push);
+
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, NextPhaseAPDebt,            Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, bOverwatchArmed,            Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, bOverwatchVisibleToEnemies, Push);
+
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, FX_Muzzle,          PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, FX_Impact,          PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, Snd_Muzzle,         PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, Snd_Impact,         PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, Snd_Selected,       PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, Snd_UnderFire,      PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, SndAttenuation,     PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, SndConcurrency,     PushInitial);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AUnitBase, ImpactDelaySeconds, PushInitial);
 }
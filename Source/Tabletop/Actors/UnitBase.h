@@ -6,12 +6,14 @@
 #include "Tabletop/ArmyData.h"
 #include "Tabletop/CombatEffects.h"   // FRollModifiers / ECombatEvent
 #include "Components/DecalComponent.h"   // ADD
+#include "Net/Serialization/FastArraySerializer.h"
 #include "UnitBase.generated.h"
 
 class UUnitAction;
 struct FUnitModifier;                 // from UnitModifiers.h
 class USphereComponent;
 class UStaticMeshComponent;
+class UInstancedStaticMeshComponent;
 class UStaticMesh;
 class ATabletopPlayerState;
 class UNiagaraSystem;
@@ -48,7 +50,101 @@ struct FActionUsageEntry
     UPROPERTY() int16  PerMatch = 0;
 };
 
+UENUM(BlueprintType)
+enum class ECombatModChange : uint8
+{
+    Added,
+    Changed,    // counters ticked (uses / turns remaining)
+    Removed
+};
+
+// One entry of AUnitBase::ActiveCombatMods; per-item dirtiness so a consume/expiry only resends that mod
+USTRUCT(BlueprintType)
+struct FActiveCombatModItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly) FUnitModifier Mod;
+
+    void PreReplicatedRemove(const struct FActiveCombatModArray& InArray);
+    void PostReplicatedAdd(const struct FActiveCombatModArray& InArray);
+    void PostReplicatedChange(const struct FActiveCombatModArray& InArray);
+};
+
+USTRUCT(BlueprintType)
+struct FActiveCombatModArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly) TArray<FActiveCombatModItem> Items;
+
+    // Not replicated; set by the owning unit's constructor
+    class AUnitBase* Owner = nullptr;
+
+    int32 Num() const { return Items.Num(); }
+
+    void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FActiveCombatModItem, FActiveCombatModArray>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FActiveCombatModArray> : public TStructOpsTypeTraitsBase2<FActiveCombatModArray>
+{
+    enum { WithNetDeltaSerializer = true };
+};
+
+// Datatable stats that never change after Server_InitFromRow, packed to 32 bits on the wire.
+// Values past a field's range are clamped when sent (T 0-31, W 0-63, saves 0-7 with 7 = none, models 0-127, OC 0-31).
+USTRUCT()
+struct FUnitStatSnapshot
+{
+    GENERATED_BODY()
+
+    UPROPERTY() uint8 Toughness  = 0;
+    UPROPERTY() uint8 Wounds     = 0;   // per model
+    UPROPERTY() uint8 Save       = 5;
+    UPROPERTY() uint8 InvulnSave = 7;
+    UPROPERTY() uint8 FeelNoPain = 7;
+    UPROPERTY() uint8 ModelsMax  = 0;
+    UPROPERTY() uint8 ObjectiveControlPerModel = 1;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FUnitStatSnapshot> : public TStructOpsTypeTraitsBase2<FUnitStatSnapshot>
+{
+    enum { WithNetSerializer = true, WithNetSharedSerialization = true };
+};
+
+// The part of a unit that changes in play: one property instead of separate pool / model count
+USTRUCT()
+struct FUnitHealthState
+{
+    GENERATED_BODY()
+
+    // Wide enough for a full unit: ModelsMax (7 bits) x Wounds (6 bits) = 127 * 63
+    static constexpr uint32 WoundsPoolBits = 13;
+    static constexpr uint32 WoundsPoolMax  = (1u << WoundsPoolBits) - 1;
+
+    UPROPERTY() uint16 WoundsPool    = 0;   // WoundsPoolBits on the wire
+    UPROPERTY() uint8  ModelsCurrent = 0;   // 7 bits
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FUnitHealthState> : public TStructOpsTypeTraitsBase2<FUnitHealthState>
+{
+    enum { WithNetSerializer = true, WithNetSharedSerialization = true };
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMoveChanged);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCombatModChanged, ECombatModChange, Change, const FUnitModifier&, Mod);
 
 UCLASS()
 class TABLETOP_API AUnitBase : public AActor
@@ -139,6 +235,11 @@ public:
     UFUNCTION(BlueprintCallable, Category="Overwatch")
     void SetOverwatchArmed(bool bArmed);
 
+    // Push-model: call on the server after writing these directly (GM / actions do)
+    void MarkTurnStateDirty();   // move budget/max, bHasShot, bMoved/bAdvancedThisTurn
+    void MarkOverwatchDirty();   // bOverwatchArmed, bOverwatchVisibleToEnemies
+    void MarkAPDebtDirty();      // NextPhaseAPDebt
+
     // ---------- Abilities ----------
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Action")
@@ -197,23 +298,32 @@ public:
     // Chosen weapon index within the row (server sets, clients read)
     UPROPERTY(Replicated) int32 WeaponIndex = 0;
 
-    // Active combat mods (REPLICATED so clients can preview/visualize)
+    // Active combat mods (REPLICATED so clients can preview/visualize), as a fast array so only touched mods go out
+    // Only mutate through AddUnitModifier / ConsumeForStage / On*Advanced so the stage index and dirty marks stay valid
     UPROPERTY(Replicated, BlueprintReadOnly)
-    TArray<FUnitModifier> ActiveCombatMods;
+    FActiveCombatModArray ActiveCombatMods;
+
+    UFUNCTION(BlueprintPure, Category="Mods")
+    TArray<FUnitModifier> GetActiveCombatMods() const;
+
+    // Fires per mod on server and clients (clients after the stage index is rebuilt), for buff UI
+    UPROPERTY(BlueprintAssignable, Category="Mods")
+    FOnCombatModChanged OnCombatModChanged;
 
     // Track move/advance this turn (REPLICATED for preview & keyword logic)
     UPROPERTY(Replicated, BlueprintReadOnly) bool bMovedThisTurn = false;
     UPROPERTY(Replicated, BlueprintReadOnly) bool bAdvancedThisTurn = false;
 
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Replicated, Category="Stats|Objective")
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stats|Objective")
     int32 ObjectiveControlPerModel = 1;
 
     UFUNCTION(BlueprintPure, Category="Objective")
     int32 GetObjectiveControlAt(const class AObjectiveMarker* Marker) const;
     
-    // ---------- Runtime state (replicated) ----------
-    UPROPERTY(ReplicatedUsing=OnRep_Models) int32 ModelsCurrent = 0;
-    UPROPERTY(Replicated)                 int32 ModelsMax     = 0;
+    // ---------- Runtime state ----------
+    // ModelsCurrent / WoundsPool travel in HealthRep, ModelsMax in StatSnapshot
+    int32 ModelsCurrent = 0;
+    int32 ModelsMax     = 0;
     UPROPERTY(Replicated)                 FText UnitName;
     
     UPROPERTY(ReplicatedUsing=OnRep_CurrentWeapon)
@@ -222,6 +332,9 @@ public:
     // Accessor used by gameplay (server authoritative)
     FORCEINLINE const FWeaponProfile& GetActiveWeaponProfile() const { return CurrentWeapon; }
 
+    // CurrentWeapon.Keywords flattened to a bitmask + values; rebuilt whenever the weapon changes (server + OnRep)
+    FORCEINLINE const FCompiledKeywordSet& GetCompiledKeywords() const { return CompiledKeywords; }
+
     
     UPROPERTY(ReplicatedUsing=OnRep_Move) float MoveBudgetInches = 0.f;
     UPROPERTY(ReplicatedUsing=OnRep_Move) float MoveMaxInches    = 0.f;
@@ -229,28 +342,36 @@ public:
     UPROPERTY(Replicated) bool bHasShot         = false;
     UPROPERTY(Replicated) AActor* CurrentTarget = nullptr;
 
-    // ---------- Replicated stat snapshot ----------
-    UPROPERTY(Replicated) int32 ToughnessRep = 0;
-    UPROPERTY(Replicated) int32 WoundsRep    = 0;
-    UPROPERTY(Replicated) int32 SaveRep      = 5;
-
-    UPROPERTY(Replicated) int32 WeaponRangeInchesRep = 0;
-    UPROPERTY(Replicated) int32 WeaponAttacksRep     = 0;
-    UPROPERTY(Replicated) int32 WeaponDamageRep      = 0;
-    UPROPERTY(Replicated) int32 WeaponSkillToHitRep  = 4;
-    UPROPERTY(Replicated) int32 WeaponStrengthRep    = 4;
-    UPROPERTY(Replicated) int32 WeaponAPRep          = 0;
+    // ---------- Stat snapshot ----------
+    // Sent once in the initial bunch, unpacked into the ints below on both sides
+    UPROPERTY(ReplicatedUsing=OnRep_StatSnapshot)
+    FUnitStatSnapshot StatSnapshot;
+
+    int32 ToughnessRep = 0;
+    int32 WoundsRep    = 0;
+    int32 SaveRep      = 5;
+
+    // Mirrors of CurrentWeapon (SyncWeaponSnapshotsFromCurrent), not sent on their own
+    int32 WeaponRangeInchesRep = 0;
+    int32 WeaponAttacksRep     = 0;
+    int32 WeaponDamageRep      = 0;
+    int32 WeaponSkillToHitRep  = 4;
+    int32 WeaponStrengthRep    = 4;
+    int32 WeaponAPRep          = 0;
     
-    UPROPERTY(Replicated, BlueprintReadOnly, Category="Stats|Defense")
+    UPROPERTY(BlueprintReadOnly, Category="Stats|Defense")
     int32 InvulnerableSaveRep = 7;
 
-    UPROPERTY(Replicated, BlueprintReadOnly, Category="Stats|Defense")
+    UPROPERTY(BlueprintReadOnly, Category="Stats|Defense")
     int32 FeelNoPainRep = 7;
     
     UFUNCTION(BlueprintPure) int32 GetInvuln() const { return InvulnerableSaveRep; }
     UFUNCTION(BlueprintPure) int32 GetFeelNoPain() const { return FeelNoPainRep; }
 
-    UPROPERTY(ReplicatedUsing=OnRep_Health) int32 WoundsPool = 0;
+    UPROPERTY(ReplicatedUsing=OnRep_HealthState)
+    FUnitHealthState HealthRep;
+
+    int32 WoundsPool = 0;
 
     int32 GetSave() const { return SaveRep; }
 
@@ -263,6 +384,22 @@ public:
     // Small helper so both Server_InitFromRow and OnRep_CurrentWeapon can call it
     void SyncWeaponSnapshotsFromCurrent();
 
+    FCompiledKeywordSet CompiledKeywords;
+
+    // Indices into ActiveCombatMods, bucketed by (stage, targeting) and by expiry, so a stage query
+    // or turn/round decay only walks the mods that can apply. Kept in step with every add/remove
+    // on the server; clients rebuild it once per received fast-array update for previews.
+    using FModIndexBucket = TArray<int32, TInlineAllocator<4>>;
+    static constexpr int32 NumModExpiryKinds = (int32)EModifierExpiry::Uses + 1;
+
+    TMap<uint16, FModIndexBucket> ModsByStage;
+    FModIndexBucket ModsByExpiry[NumModExpiryKinds];
+
+    void IndexModAt(int32 Idx);
+    void RemoveModAt(int32 Idx);   // RemoveAtSwap + index fix-up
+    void MarkCombatModChanged(FActiveCombatModItem& Item);
+    void RebuildModIndex();
+
     // Mods API (no bespoke debuff funcs)
     void AddUnitModifier(const FUnitModifier& Mod);
     FRollModifiers CollectStageMods(ECombatEvent Stage, bool bAsAttacker, const class AUnitBase* Opponent) const;
@@ -270,7 +407,13 @@ public:
     void OnTurnAdvanced();
     void OnRoundAdvanced();
 
-    UFUNCTION() void OnRep_Health();
+    // Client side of the fast array: per-item callbacks queue, the receive callback reindexes then broadcasts
+    void QueueCombatModEvent(ECombatModChange Change, const FUnitModifier& Mod);
+    void OnCombatModsReceived();
+    TArray<TPair<ECombatModChange, FUnitModifier>> PendingCombatModEvents;
+
+    UFUNCTION() void OnRep_StatSnapshot();
+    UFUNCTION() void OnRep_HealthState();
     
     // Init from spawn params (server only)
     void Server_InitFromRow(APlayerState* OwnerPS, const FUnitRow& Row, int32 InWeaponIndex);
@@ -295,6 +438,17 @@ public:
     UFUNCTION(BlueprintCallable, Category="Facing")
     void FaceNearestEnemyInstant();
 
+    // Server-side nearest-enemy cache; the GM keeps it current incrementally as units move (NotifyUnitTransformChanged)
+    AUnitBase* GetCachedNearestEnemy() const { return CachedNearestEnemy.Get(); }
+    float GetCachedNearestEnemyDistSq() const { return CachedNearestEnemyDistSq; }
+    void SetCachedNearestEnemy(AUnitBase* Enemy, float DistSq) { CachedNearestEnemy = Enemy; CachedNearestEnemyDistSq = Enemy ? DistSq : TNumericLimits<float>::Max(); }
+    AUnitBase* RefreshNearestEnemyCache(); // full (index) lookup
+
+    // Bumped whenever the unit moves, turns or re-lays its models; the GM's cover cache keys off it
+    // and the spatial index re-buckets the unit
+    uint32 GetTransformVersion() const { return TransformVersion; }
+    void   BumpTransformVersion();
+
     UFUNCTION(BlueprintPure, Category="Teams")
     bool IsEnemy(const AUnitBase* Other) const;
     
@@ -336,6 +490,20 @@ public:
     UPROPERTY(ReplicatedUsing=OnRep_VFXAudio)
     float ImpactDelaySeconds = 1.0f;
 
+    // Pooled components primed per FX asset once this unit knows its FX (see UTabletopFXPoolSubsystem)
+    UPROPERTY(EditDefaultsOnly, Category="VFX|Pool", meta=(ClampMin="0"))
+    int32 FXPrewarmMuzzle = 8;
+
+    UPROPERTY(EditDefaultsOnly, Category="VFX|Pool", meta=(ClampMin="0"))
+    int32 FXPrewarmImpact = 8;
+
+    // Volleys from more models than this only render FXVolleyRepresentatives muzzles/impacts (0 = always render all)
+    UPROPERTY(EditDefaultsOnly, Category="VFX|Pool", meta=(ClampMin="0"))
+    int32 FXVolleyAggregateAbove = 8;
+
+    UPROPERTY(EditDefaultsOnly, Category="VFX|Pool", meta=(ClampMin="1"))
+    int32 FXVolleyRepresentatives = 6;
+
     UFUNCTION()
     void OnRep_VFXAudio();
 
@@ -371,7 +539,15 @@ public:
     UPROPERTY(EditDefaultsOnly, Category="Selection")
     bool bUseComplexForSelection = true;
 
-    UPROPERTY() TArray<UStaticMeshComponent*> ModelMeshes;
+    // All models of the unit are instances of this one component (instance i == model i).
+    // Losing/moving a model updates instances in place instead of creating/destroying components.
+    UPROPERTY(VisibleAnywhere, Category="Unit|Visual")
+    UInstancedStaticMeshComponent* ModelInstances = nullptr;
+
+    // Per-model queries (what used to be read straight off the per-model components)
+    int32      GetNumModelVisuals() const { return ModelLocalXforms.Num(); }
+    FTransform GetModelWorldTransform(int32 ModelIndex) const;
+    FVector    GetModelImpactPoint(int32 ModelIndex) const;
 
     UFUNCTION(BlueprintPure, Category="VFX")
     int32 FindBestShooterModelIndex(const FVector& TargetWorld) const;
@@ -392,9 +568,18 @@ public:
     
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type Reason) override;
+    virtual void PostNetReceiveLocationAndRotation() override;
 
-    UFUNCTION()
-    void OnRep_Models();
+    uint32 TransformVersion = 0;
+
+    TWeakObjectPtr<AUnitBase> CachedNearestEnemy;
+    float CachedNearestEnemyDistSq = TNumericLimits<float>::Max();
+
+    // Server: copy the unpacked ints into the replicated structs after changing them
+    void PackStatSnapshot();
+    void PackHealthState();
+    void MarkInitStateDirty();   // everything Server_InitFromRow writes once
     
     void EnsureRangeDecal();
     void SetRangeVisible(float RadiusCm, const FLinearColor& Color, ERangeVizMode Mode);
@@ -445,11 +630,29 @@ protected:
     
     
 
+    // Optional single overlay that reads PerInstanceCustomData[0] (EUnitHighlight as float, 0 = none).
+    // When set it stays on the instances and only the custom data changes; otherwise the per-mode materials above are swapped.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Selection|Outline")
+    UMaterialInterface* OutlineInstancedMaterial = nullptr;
+
 private:
     UPROPERTY()
     TArray<UMaterialInstanceDynamic*> HighlightMIDs;
     
     void ApplyOutlineToAllModels(UMaterialInterface* Mat);
+    void ApplyHighlightCustomData(int32 FirstInstance = 0);
+
+    // Instance transforms relative to the unit (mirrors ModelInstances so we never read back from the render side)
+    TArray<FTransform> ModelLocalXforms;
+    void PushModelTransforms();
+
+    // Socket transforms relative to one model, read off ModelMesh once instead of per query
+    void CacheModelSockets();
+    TWeakObjectPtr<UStaticMesh> CachedSocketMesh;
+    FTransform MuzzleSocketLocal = FTransform::Identity;
+    FTransform ImpactSocketLocal = FTransform::Identity;
+    bool bHasMuzzleSocket = false;
+    bool bHasImpactSocket = false;
 
     EUnitHighlight CurrentHighlight = EUnitHighlight::None;
 };
@@ -0,0 +1,138 @@
+#include "CombatDice.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogTabletopDice);
+
+void FCombatDice::RollD6Into(uint8* Dst, int32 N)
+{
+	for (int32 i = 0; i < N; ++i)
+	{
+		Dst[i] = RollDie(6);
+	}
+}
+
+int32 FMatchDiceService::DeriveSubstreamSeed(int32 InMatchSeed, int32 Index)
+{
+	// Mix so neighbouring attacks don't get neighbouring LCG seeds
+	return (int32)HashCombine(GetTypeHash(InMatchSeed), GetTypeHash(Index) * 2654435761u);
+}
+
+void FMatchDiceService::SeedMatch(int32 Seed)
+{
+	if (Seed == 0)
+	{
+		Seed = (int32)(FPlatformTime::Cycles() ^ (uint32)FMath::Rand());
+		if (Seed == 0) Seed = 1;
+	}
+
+	MatchSeed      = Seed;
+	SubstreamCount = 0;
+	bSeeded        = true;
+
+	UE_LOG(LogTabletopDice, Log, TEXT("[Dice] Match seed = %d (replay with -TabletopDiceSeed=%d)"), MatchSeed, MatchSeed);
+	OnSeedLogged.Broadcast(TEXT("Match"), INDEX_NONE, MatchSeed);
+}
+
+FCombatDice FMatchDiceService::BeginSubstream(const FString& Label)
+{
+	if (!bSeeded)
+	{
+		SeedMatch(0);
+	}
+
+	const int32 Index = SubstreamCount++;
+	const int32 Seed  = DeriveSubstreamSeed(MatchSeed, Index);
+
+	UE_LOG(LogTabletopDice, Verbose, TEXT("[Dice] #%d %s seed=%d"), Index, *Label, Seed);
+	OnSeedLogged.Broadcast(Label, Index, Seed);
+
+	return FCombatDice(Seed);
+}
+
+void DiceKernel::RerollFailures(FCombatDice& Dice, uint8* R, int32 N, int32 Need, bool bRerollAll, bool bRerollOnes)
+{
+	if (!bRerollAll && !bRerollOnes) return;
+
+	// Rerollable dice: failures (all) or natural 1s that failed
+	const uint8 T = (uint8)FMath::Clamp(Need, 0, 255);
+	const uint8 Cut = bRerollAll ? T : (uint8)FMath::Min<int32>(2, T);
+
+	int32 Pending = 0;
+	for (int32 i = 0; i < N; ++i) Pending += (R[i] < Cut);
+	if (Pending == 0) return;
+
+	TArray<uint8, TInlineAllocator<64>> Fresh;
+	Dice.RollD6Batch(Pending, Fresh);
+
+	int32 k = 0;
+	for (int32 i = 0; i < N && k < Pending; ++i)
+	{
+		if (R[i] < Cut) R[i] = Fresh[k++];
+	}
+}
+
+#if !(UE_BUILD_SHIPPING)
+// Tabletop.Bench.Dice [Dice=120] [Iters=20000]
+// Old path (one RollDie per die, branchy counting, per-die Add) vs the batch kernel, hit->wound->save->FNP.
+// Both sides draw from the same per-die primitive so only the looping/counting differs.
+static void BenchDice(const TArray<FString>& Args)
+{
+	const int32 NumDice = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 120;
+	const int32 Iters   = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20000;
+
+	int64 SinkScalar = 0, SinkBatch = 0;
+
+	// scalar
+	double T0 = FPlatformTime::Seconds();
+	{
+		FCombatDice Dice(1234);
+		TArray<uint8> HitRolls, WoundRolls;
+		for (int32 It = 0; It < Iters; ++It)
+		{
+			HitRolls.Reset(); WoundRolls.Reset();
+			int32 Hits = 0, Wounds = 0, Unsaved = 0, Prevented = 0;
+			for (int32 i = 0; i < NumDice; ++i) { const int32 r = Dice.RollDie(6); if (r >= 3) ++Hits; HitRolls.Add((uint8)r); }
+			int32 Crits = 0;
+			for (uint8 r : HitRolls) if (r >= 6) ++Crits;
+			Hits += Crits;
+			for (int32 i = 0; i < Hits; ++i) { const int32 r = Dice.RollDie(6); if (r >= 4) ++Wounds; WoundRolls.Add((uint8)r); }
+			for (int32 i = 0; i < Wounds; ++i) if (Dice.RollDie(6) < 4) ++Unsaved;
+			for (int32 i = 0; i < Unsaved; ++i) if (Dice.RollDie(6) >= 5) ++Prevented;
+			SinkScalar += Unsaved - Prevented;
+		}
+	}
+	const double Scalar = FPlatformTime::Seconds() - T0;
+
+	// batch
+	T0 = FPlatformTime::Seconds();
+	{
+		FCombatDice Dice(1234);
+		TArray<uint8> Buf;
+		for (int32 It = 0; It < Iters; ++It)
+		{
+			Dice.RollD6Batch(NumDice, Buf);
+			int32 Hits = 0, Crits = 0;
+			DiceKernel::CountSuccessAndCrits(Buf.GetData(), Buf.Num(), 3, 6, Hits, Crits);
+			Hits += Crits;
+			const int32 Wounds  = DiceKernel::RollAndCount(Dice, Hits, 4, Buf);
+			const int32 Unsaved = Wounds - DiceKernel::RollAndCount(Dice, Wounds, 4, Buf);
+			const int32 Prevent = DiceKernel::RollAndCount(Dice, Unsaved, 5, Buf);
+			SinkBatch += Unsaved - Prevent;
+		}
+	}
+	const double Batch = FPlatformTime::Seconds() - T0;
+
+	UE_LOG(LogTabletopDice, Display, TEXT("[Bench.Dice] %d dice x %d volleys: scalar %.3f ms (%.1f ns/volley)  batch %.3f ms (%.1f ns/volley)  x%.1f  [sink %lld/%lld]"),
+		NumDice, Iters,
+		Scalar * 1000.0, Scalar * 1e9 / Iters,
+		Batch  * 1000.0, Batch  * 1e9 / Iters,
+		Batch > 0.0 ? Scalar / Batch : 0.0,
+		SinkScalar, SinkBatch);
+}
+
+static FAutoConsoleCommand GBenchDiceCmd(
+	TEXT("Tabletop.Bench.Dice"),
+	TEXT("Microbenchmark: scalar vs batched dice kernel. Args: [Dice=120] [Iters=20000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchDice));
+#endif
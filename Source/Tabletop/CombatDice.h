@@ -0,0 +1,117 @@
+// CombatDice.h
+#pragma once
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTabletopDice, Log, All);
+
+// A single dice stream. Each attack (or other server roll) gets its own substream
+// derived from the match seed, so a resolution can be replayed bit-for-bit offline.
+struct TABLETOP_API FCombatDice
+{
+	FCombatDice() = default;
+	explicit FCombatDice(int32 InSeed) : Stream(InSeed) {}
+
+	FRandomStream Stream;
+
+	// Unbiased enough for dice: scale the full 32 bits instead of modulo (LCG low bits are poor)
+	FORCEINLINE uint8 RollDie(uint32 Sides) { return (uint8)(1 + ((uint64(Stream.GetUnsignedInt()) * Sides) >> 32)); }
+
+	FORCEINLINE int32 D6() { return RollDie(6); }
+	FORCEINLINE int32 D3() { return RollDie(3); }
+
+	// Out is resized to N (old contents discarded)
+	template<typename AllocatorType>
+	void RollD6Batch(int32 N, TArray<uint8, AllocatorType>& Out)
+	{
+		Out.SetNumUninitialized(FMath::Max(0, N));
+		RollD6Into(Out.GetData(), Out.Num());
+	}
+
+	void RollD6Into(uint8* Dst, int32 N);
+
+	int32 GetInitialSeed() const { return Stream.GetInitialSeed(); }
+};
+
+// Fired whenever a seed is picked/derived: (Label, Index, Seed). Index is INDEX_NONE for the match seed.
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnDiceSeedLogged, const FString& /*Label*/, int32 /*Index*/, int32 /*Seed*/);
+
+// Owned by AMatchGameMode. Seeded once per match; hands out per-attack substreams.
+class TABLETOP_API FMatchDiceService
+{
+public:
+	// Seed==0 picks a fresh seed
+	void SeedMatch(int32 Seed);
+
+	// Next substream in match order. Label only goes to the log / hook.
+	FCombatDice BeginSubstream(const FString& Label);
+
+	int32 GetMatchSeed() const { return MatchSeed; }
+	int32 GetSubstreamCount() const { return SubstreamCount; }
+	bool  IsSeeded() const { return bSeeded; }
+
+	// Hook for recorders / profiling captures
+	FOnDiceSeedLogged OnSeedLogged;
+
+	static int32 DeriveSubstreamSeed(int32 MatchSeed, int32 Index);
+
+private:
+	int32 MatchSeed = 0;
+	int32 SubstreamCount = 0;
+	bool  bSeeded = false;
+};
+
+// Batched dice kernels. Roll a whole stage into a contiguous uint8 buffer, then count with
+// branch-free loops (the compare folds into an add, so the compiler can vectorize them).
+namespace DiceKernel
+{
+	// Number of dice showing Need or better
+	FORCEINLINE int32 CountAtLeast(const uint8* Rolls, int32 N, int32 Need)
+	{
+		const uint8 T = (uint8)FMath::Clamp(Need, 0, 255);
+		int32 Count = 0;
+		for (int32 i = 0; i < N; ++i)
+		{
+			Count += (Rolls[i] >= T);
+		}
+		return Count;
+	}
+
+	template<typename AllocatorType>
+	FORCEINLINE int32 CountAtLeast(const TArray<uint8, AllocatorType>& Rolls, int32 Need)
+	{
+		return CountAtLeast(Rolls.GetData(), Rolls.Num(), Need);
+	}
+
+	// Successes and crits in one pass
+	FORCEINLINE void CountSuccessAndCrits(const uint8* Rolls, int32 N, int32 Need, int32 CritAt, int32& OutSuccess, int32& OutCrits)
+	{
+		const uint8 T = (uint8)FMath::Clamp(Need, 0, 255);
+		const uint8 C = (uint8)FMath::Clamp(CritAt, 0, 255);
+		int32 S = 0, K = 0;
+		for (int32 i = 0; i < N; ++i)
+		{
+			S += (Rolls[i] >= T);
+			K += (Rolls[i] >= C);
+		}
+		OutSuccess = S;
+		OutCrits   = K;
+	}
+
+	// Re-roll failed dice in place (all failures, or just natural 1s). Rolls the replacements as one batch.
+	TABLETOP_API void RerollFailures(FCombatDice& Dice, uint8* Rolls, int32 N, int32 Need, bool bRerollAll, bool bRerollOnes);
+
+	template<typename AllocatorType>
+	FORCEINLINE void RerollFailures(FCombatDice& Dice, TArray<uint8, AllocatorType>& Rolls, int32 Need, bool bRerollAll, bool bRerollOnes)
+	{
+		RerollFailures(Dice, Rolls.GetData(), Rolls.Num(), Need, bRerollAll, bRerollOnes);
+	}
+
+	// Rolls N dice into Out and returns how many made Need (Out keeps the dice for crit checks)
+	template<typename AllocatorType>
+	FORCEINLINE int32 RollAndCount(FCombatDice& Dice, int32 N, int32 Need, TArray<uint8, AllocatorType>& Out)
+	{
+		Dice.RollD6Batch(N, Out);
+		return CountAtLeast(Out, Need);
+	}
+}
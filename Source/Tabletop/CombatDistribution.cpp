@@ -0,0 +1,255 @@
+#include "CombatDistribution.h"
+
+#include "Async/Async.h"
+
+namespace
+{
+	constexpr double OneSixth = 1.0 / 6.0;
+
+	// P(natural 6) after rerolls; a 6 always passes so only failures get rerolled
+	double ProbCrit(int32 Need, bool bRerollAll, bool bRerollOnes)
+	{
+		const double P = FCombatDistribution::ProbAtLeast(Need);
+		if (bRerollAll)  return OneSixth + (1.0 - P) * OneSixth;
+		if (bRerollOnes) return OneSixth + OneSixth * OneSixth;
+		return OneSixth;
+	}
+
+	void Convolve(const TArray<double>& A, const TArray<double>& B, TArray<double>& Out)
+	{
+		Out.SetNumZeroed(A.Num() + B.Num() - 1);
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			if (A[i] == 0.0) continue;
+			for (int32 j = 0; j < B.Num(); ++j)
+			{
+				Out[i + j] += A[i] * B[j];
+			}
+		}
+	}
+
+	// Binomial(N, P) added into Out scaled by Weight
+	void AddBinomial(int32 N, double P, double Weight, TArray<double>& Out)
+	{
+		if (Out.Num() < N + 1) Out.SetNumZeroed(N + 1);
+
+		if (P <= 0.0) { Out[0] += Weight; return; }
+		if (P >= 1.0) { Out[N] += Weight; return; }
+
+		const double Ratio = P / (1.0 - P);
+		double Term = FMath::Pow(1.0 - P, (double)N);
+		for (int32 k = 0; k <= N; ++k)
+		{
+			Out[k] += Weight * Term;
+			Term *= Ratio * double(N - k) / double(k + 1);
+		}
+	}
+}
+
+double FCombatDistribution::ProbAtLeast(int32 Need, bool bRerollAll, bool bRerollOnes)
+{
+	if (Need <= 1) return 1.0;
+	if (Need >= 7) return 0.0;
+
+	const double P = double(7 - Need) * OneSixth;
+	if (bRerollAll)  return P + (1.0 - P) * P;
+	if (bRerollOnes) return P + OneSixth * P;
+	return P;
+}
+
+FCombatEstimate FCombatDistribution::Compute(const FCombatEstimateInput& In)
+{
+	FCombatEstimate R;
+
+	const int32 Pool = FMath::Max(0, In.TargetPool);
+	const int32 WPM  = FMath::Max(1, In.WoundsPerModel);
+
+	// --- single-die probabilities ---
+	const double PHitAny  = In.bAutoHit ? 1.0 : ProbAtLeast(In.HitNeed);
+	const double PHitCrit = In.bAutoHit ? 0.0 : OneSixth;
+	const double PHitNorm = FMath::Max(0.0, PHitAny - PHitCrit);
+
+	const double PWound     = ProbAtLeast(In.WoundNeed, In.bRerollAllWounds, In.bRerollOnesWounds);
+	const double PWoundCrit = ProbCrit(In.WoundNeed, In.bRerollAllWounds, In.bRerollOnesWounds);
+	const double PWoundNorm = FMath::Max(0.0, PWound - PWoundCrit);
+
+	const double PFailSave = 1.0 - ProbAtLeast(In.SaveNeed);
+
+	// one hit rolling to wound -> P(one unsaved wound)
+	const double PUnsaved = In.bDevastatingWounds
+		? (PWoundCrit + PWoundNorm * PFailSave)
+		: (PWound * PFailSave);
+
+	// crit hit: Lethal turns the hit itself into an auto-wound (still saved); Sustained adds X more hits
+	const double PCritFirst = In.bLethalHits ? PFailSave : PUnsaved;
+	const int32  Sus = FMath::Max(0, In.SustainedHits);
+
+	// --- per-attack unsaved wound pmf over [0 .. 1+Sus] ---
+	TArray<double> PerAttack;
+	{
+		TArray<double> Crit;
+		AddBinomial(Sus, PUnsaved, 1.0, Crit);
+		TArray<double> First = { 1.0 - PCritFirst, PCritFirst };
+		TArray<double> CritOut;
+		Convolve(First, Crit, CritOut);
+
+		PerAttack.SetNumZeroed(Sus + 2);
+		PerAttack[0] += 1.0 - PHitAny;
+		PerAttack[0] += PHitNorm * (1.0 - PUnsaved);
+		PerAttack[1] += PHitNorm * PUnsaved;
+		for (int32 i = 0; i < CritOut.Num(); ++i) PerAttack[i] += PHitCrit * CritOut[i];
+	}
+
+	// --- attack count (fixed + optional D3/D6) ---
+	const int32 Extra = (In.ExtraAttackDie == 3 || In.ExtraAttackDie == 6) ? In.ExtraAttackDie : 0;
+	const int32 BaseN = FMath::Max(0, In.Attacks);
+	const int32 MaxN  = BaseN + Extra;
+
+	TArray<double> Unsaved; // P(total unsaved wounds == u)
+	{
+		TArray<double> Cur = { 1.0 }, Next;
+		auto Weight = [&](int32 N) -> double
+		{
+			if (Extra == 0) return (N == BaseN) ? 1.0 : 0.0;
+			return (N > BaseN && N <= MaxN) ? 1.0 / Extra : 0.0;
+		};
+		auto Accumulate = [&](double W)
+		{
+			if (W <= 0.0) return;
+			if (Unsaved.Num() < Cur.Num()) Unsaved.SetNumZeroed(Cur.Num());
+			for (int32 i = 0; i < Cur.Num(); ++i) Unsaved[i] += W * Cur[i];
+		};
+
+		Accumulate(Weight(0));
+		for (int32 N = 1; N <= MaxN; ++N)
+		{
+			Convolve(Cur, PerAttack, Next);
+			Swap(Cur, Next);
+			Accumulate(Weight(N));
+		}
+	}
+
+	// --- damage: x Damage, LOS cap, then FNP per point ---
+	const int32  Dmg     = FMath::Max(0, In.Damage); // server multiplies by the raw value; <= 0 deals nothing
+	const double PIgnore = ProbAtLeast(In.FnpNeed);
+
+	TArray<double> PreFnp;
+	for (int32 u = 0; u < Unsaved.Num(); ++u)
+	{
+		if (Unsaved[u] == 0.0) continue;
+		int32 D = u * Dmg;
+		if (In.DamageCap > 0) D = FMath::Min(D, In.DamageCap);
+		if (PreFnp.Num() < D + 1) PreFnp.SetNumZeroed(D + 1);
+		PreFnp[D] += Unsaved[u];
+	}
+
+	TArray<double> Final;
+	for (int32 d = 0; d < PreFnp.Num(); ++d)
+	{
+		if (PreFnp[d] == 0.0) continue;
+		AddBinomial(d, 1.0 - PIgnore, PreFnp[d], Final);
+	}
+
+	// --- fold into the unit's remaining pool ---
+	R.DamagePmf.SetNumZeroed(Pool + 1);
+	R.ModelsKilledPmf.SetNumZeroed(FMath::Max(0, In.TargetModels) + 1);
+	for (int32 d = 0; d < Final.Num(); ++d)
+	{
+		const double P = Final[d];
+		if (P == 0.0) continue;
+
+		const int32 Applied   = FMath::Min(d, Pool);
+		const int32 PoolLeft  = Pool - Applied;
+		const int32 ModelsNow = FMath::Min((PoolLeft + WPM - 1) / WPM, In.TargetModels);
+		const int32 Killed    = FMath::Clamp(In.TargetModels - ModelsNow, 0, In.TargetModels);
+
+		R.DamagePmf[Applied]      += P;
+		R.ModelsKilledPmf[Killed] += P;
+		R.ExpectedDamage          += P * Applied;
+		R.ExpectedModelsKilled    += P * Killed;
+	}
+	R.KillUnitChance = (Pool > 0) ? R.DamagePmf[Pool] : 1.0;
+
+	return R;
+}
+
+// ---------------- cache ----------------
+
+FCombatEstimateCache& FCombatEstimateCache::Get()
+{
+	static FCombatEstimateCache Instance;
+	return Instance;
+}
+
+TSharedPtr<const FCombatEstimate> FCombatEstimateCache::FindOrRequest(const FCombatEstimateInput& In, FOnCombatEstimateReady OnReady)
+{
+	check(IsInGameThread());
+
+	if (FEntry* Hit = Entries.Find(In))
+	{
+		Hit->LastUsed = ++UseClock;
+		return Hit->Result;
+	}
+
+	if (TArray<FOnCombatEstimateReady>* Waiters = InFlight.Find(In))
+	{
+		Waiters->Add(OnReady);
+		return nullptr;
+	}
+
+	InFlight.Add(In).Add(OnReady);
+
+	Async(EAsyncExecution::ThreadPool, [In]()
+	{
+		TSharedPtr<const FCombatEstimate> Result = MakeShared<FCombatEstimate>(FCombatDistribution::Compute(In));
+		AsyncTask(ENamedThreads::GameThread, [In, Result]()
+		{
+			FCombatEstimateCache::Get().Complete(In, Result);
+		});
+	});
+
+	return nullptr;
+}
+
+void FCombatEstimateCache::Complete(const FCombatEstimateInput& In, TSharedPtr<const FCombatEstimate> Result)
+{
+	// Drop the least recently used entry so the pairs being hovered right now stay warm
+	if (Entries.Num() >= MaxEntries && !Entries.Contains(In))
+	{
+		EvictOldest();
+	}
+	Entries.Add(In, { Result, ++UseClock });
+
+	TArray<FOnCombatEstimateReady> Waiters;
+	InFlight.RemoveAndCopyValue(In, Waiters);
+	for (FOnCombatEstimateReady& W : Waiters)
+	{
+		W.ExecuteIfBound();
+	}
+}
+
+void FCombatEstimateCache::EvictOldest()
+{
+	// Only runs on a miss with a full cache; a scan over MaxEntries is cheaper than keeping a list in sync
+	const FCombatEstimateInput* Oldest = nullptr;
+	uint64 OldestUse = MAX_uint64;
+	for (const TPair<FCombatEstimateInput, FEntry>& It : Entries)
+	{
+		if (It.Value.LastUsed < OldestUse)
+		{
+			OldestUse = It.Value.LastUsed;
+			Oldest    = &It.Key;
+		}
+	}
+	if (Oldest)
+	{
+		const FCombatEstimateInput Key = *Oldest;
+		Entries.Remove(Key);
+	}
+}
+
+void FCombatEstimateCache::Reset()
+{
+	Entries.Reset();
+	UseClock = 0;
+}
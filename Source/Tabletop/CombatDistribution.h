@@ -0,0 +1,115 @@
+// CombatDistribution.h
+#pragma once
+#include "CoreMinimal.h"
+
+// Fully-resolved numbers for one volley, as the server would end up with them after
+// keywords, unit modifiers and cover. Everything the distribution depends on lives here,
+// so its hash is the cache key.
+struct FCombatEstimateInput
+{
+	int32 Attacks        = 0;  // fixed attacks
+	int32 ExtraAttackDie = 0;  // 0, 3 or 6: add a D3/D6 to Attacks (Blast fallback)
+	bool  bAutoHit       = false;
+
+	int32 HitNeed   = 4;
+	int32 WoundNeed = 4;
+	int32 SaveNeed  = 7;  // 7 = no save
+	int32 FnpNeed   = 7;  // 7 = none
+	int32 Damage    = 1;
+
+	int32 SustainedHits = 0;   // extra hits per crit hit
+	bool  bLethalHits   = false;
+	bool  bDevastatingWounds = false;
+	bool  bRerollAllWounds   = false;
+	bool  bRerollOnesWounds  = false;
+
+	int32 WoundsPerModel = 1;
+	int32 TargetModels   = 1;
+	int32 TargetPool     = 1;  // current wounds left on the target unit
+	int32 DamageCap      = 0;  // LOS clamp before FNP (visible models * wounds per model); <=0 = none
+
+	bool operator==(const FCombatEstimateInput& O) const
+	{
+		return Attacks == O.Attacks && ExtraAttackDie == O.ExtraAttackDie && bAutoHit == O.bAutoHit
+			&& HitNeed == O.HitNeed && WoundNeed == O.WoundNeed && SaveNeed == O.SaveNeed
+			&& FnpNeed == O.FnpNeed && Damage == O.Damage
+			&& SustainedHits == O.SustainedHits && bLethalHits == O.bLethalHits
+			&& bDevastatingWounds == O.bDevastatingWounds
+			&& bRerollAllWounds == O.bRerollAllWounds && bRerollOnesWounds == O.bRerollOnesWounds
+			&& WoundsPerModel == O.WoundsPerModel && TargetModels == O.TargetModels
+			&& TargetPool == O.TargetPool && DamageCap == O.DamageCap;
+	}
+
+	friend uint32 GetTypeHash(const FCombatEstimateInput& I)
+	{
+		const uint32 Flags = (I.bAutoHit ? 1u : 0u) | (I.bLethalHits ? 2u : 0u) | (I.bDevastatingWounds ? 4u : 0u)
+						   | (I.bRerollAllWounds ? 8u : 0u) | (I.bRerollOnesWounds ? 16u : 0u);
+
+		uint32 H = GetTypeHash(I.Attacks);
+		H = HashCombine(H, GetTypeHash(I.ExtraAttackDie | (I.HitNeed << 4) | (I.WoundNeed << 8) | (I.SaveNeed << 12) | (I.FnpNeed << 16)));
+		H = HashCombine(H, GetTypeHash(I.Damage));
+		H = HashCombine(H, GetTypeHash(I.SustainedHits));
+		H = HashCombine(H, Flags);
+		H = HashCombine(H, GetTypeHash(I.WoundsPerModel));
+		H = HashCombine(H, GetTypeHash(I.TargetModels));
+		H = HashCombine(H, GetTypeHash(I.TargetPool));
+		H = HashCombine(H, GetTypeHash(I.DamageCap));
+		return H;
+	}
+};
+
+struct FCombatEstimate
+{
+	// P(final damage == i), i in [0 .. TargetPool]; the last bucket also holds all overkill
+	TArray<double> DamagePmf;
+	// P(exactly i models removed)
+	TArray<double> ModelsKilledPmf;
+
+	double ExpectedDamage = 0.0;
+	double ExpectedModelsKilled = 0.0;
+	double KillUnitChance = 0.0;
+};
+
+/** Exact dynamic-programming damage distribution for one volley (hit -> wound -> save -> FNP). */
+class TABLETOP_API FCombatDistribution
+{
+public:
+	static FCombatEstimate Compute(const FCombatEstimateInput& In);
+
+	// Probability a D6 (with optional rerolls) shows Need or better
+	static double ProbAtLeast(int32 Need, bool bRerollAll = false, bool bRerollOnes = false);
+};
+
+DECLARE_DELEGATE(FOnCombatEstimateReady);
+
+/**
+ * Game-thread cache in front of FCombatDistribution. Misses are computed on a worker thread;
+ * OnReady fires back on the game thread once the entry exists.
+ */
+class TABLETOP_API FCombatEstimateCache
+{
+public:
+	static FCombatEstimateCache& Get();
+
+	// Cached result, or null (and a background compute is kicked off)
+	TSharedPtr<const FCombatEstimate> FindOrRequest(const FCombatEstimateInput& In, FOnCombatEstimateReady OnReady);
+
+	void Reset();
+
+private:
+	void Complete(const FCombatEstimateInput& In, TSharedPtr<const FCombatEstimate> Result);
+
+	void EvictOldest();
+
+	struct FEntry
+	{
+		TSharedPtr<const FCombatEstimate> Result;
+		uint64 LastUsed = 0;
+	};
+
+	TMap<FCombatEstimateInput, FEntry> Entries;
+	TMap<FCombatEstimateInput, TArray<FOnCombatEstimateReady>> InFlight;
+	uint64 UseClock = 0;
+
+	static constexpr int32 MaxEntries = 256;
+};
@@ -0,0 +1,147 @@
+#include "CombatSimulator.h"
+#include "LibraryHelpers.h"
+
+static bool MatchesRole(const FUnitModifier& M, bool bAsAttacker)
+{
+	if (M.Targeting == EModifierTarget::OwnerAlways)        return true;
+	if (M.Targeting == EModifierTarget::OwnerWhenAttacking) return bAsAttacker;
+	if (M.Targeting == EModifierTarget::OwnerWhenDefending) return !bAsAttacker;
+	return false;
+}
+
+FRollModifiers FCombatSimulator::CollectMods(const TArray<FUnitModifier>& Mods, ECombatEvent Stage, bool bAsAttacker)
+{
+	FRollModifiers Out;
+	for (const FUnitModifier& M : Mods)
+	{
+		if (M.AppliesAt != Stage) continue;
+		if (!MatchesRole(M, bAsAttacker)) continue;
+		Out.Accumulate(M.Mods);
+	}
+	return Out;
+}
+
+FSimAttackResult FCombatSimulator::Resolve(const FUnitRow& AttackerRow,
+										   int32 AttackerModels,
+										   const FWeaponProfile& W,
+										   const TArray<FUnitModifier>& AttackerMods,
+										   const FSimTargetStats& T,
+										   const FSimAttackParams& P,
+										   FCombatDice& Dice)
+{
+	FSimAttackResult R;
+	const int32 Models = FMath::Max(0, AttackerModels);
+	if (Models <= 0 || T.Models <= 0) return R;
+
+	auto StageMods = [&](ECombatEvent Stage)
+	{
+		FRollModifiers M = CollectMods(AttackerMods, Stage, /*bAsAttacker*/true);
+		M.Accumulate(CollectMods(T.Mods, Stage, /*bAsAttacker*/false));
+		return M;
+	};
+
+	// Units cache the compiled set per weapon; a loose profile compiles here once per resolve
+	FAttackPlanSetup Setup;
+	Setup.AttackerModels    = Models;
+	Setup.TargetModels      = T.Models;
+	Setup.TargetToughness   = T.Toughness;
+	Setup.RangeInches       = P.RangeInches;
+	Setup.bAttackerMoved    = P.bMoved;
+	Setup.bAttackerAdvanced = P.bAdvanced;
+	const FAttackPlan Plan = FAttackPlan::Build(W, FCompiledKeywordSet::Build(W.Keywords), Setup);
+
+	int32 Attacks   = Plan.Attacks;
+	int32 HitNeed   = Plan.HitNeed;
+	int32 WoundNeed = Plan.WoundNeed;
+	int32 AP        = Plan.AP;
+	int32 Damage    = Plan.Damage;
+
+	// ===== PreHitCalc =====
+	FRollModifiers M = StageMods(ECombatEvent::PreHitCalc);
+	Plan.FoldStage(ECombatEvent::PreHitCalc, M, &Dice);
+
+	Attacks += M.AttacksDelta;
+	HitNeed  = FMath::Clamp(HitNeed + M.HitNeedOffset, 2, 6);
+	HitNeed  = FMath::Clamp(HitNeed + (P.CoverHitMod * -1), 2, 6);
+
+	TArray<uint8, TInlineAllocator<128>> Rolls;
+	int32 Hits = 0, HitCrits = 0, Wounds = 0;
+	if (M.bAutoHit)
+	{
+		Hits = Attacks;
+	}
+	else
+	{
+		Dice.RollD6Batch(Attacks, Rolls);
+		DiceKernel::CountSuccessAndCrits(Rolls.GetData(), Rolls.Num(), HitNeed, Plan.CritHitAt, Hits, HitCrits);
+	}
+	Plan.ApplyHitCrits(HitCrits, Hits, Wounds);
+
+	// ===== PreWoundCalc =====
+	M = StageMods(ECombatEvent::PreWoundCalc);
+	Plan.FoldStage(ECombatEvent::PreWoundCalc, M, &Dice);
+	WoundNeed = FMath::Clamp(WoundNeed + M.WoundNeedOffset, 2, 6);
+
+	Dice.RollD6Batch(FMath::Max(0, Hits - Wounds), Rolls);
+	DiceKernel::RerollFailures(Dice, Rolls, WoundNeed, M.bRerollAllWounds, M.bRerollOnesWounds);
+
+	int32 NewWounds = 0, WoundCrits = 0;
+	DiceKernel::CountSuccessAndCrits(Rolls.GetData(), Rolls.Num(), WoundNeed, Plan.CritWoundAt, NewWounds, WoundCrits);
+	Wounds += NewWounds;
+
+	int32 CritNoSave = 0;
+	Plan.ApplyWoundCrits(WoundCrits, CritNoSave);
+
+	// ===== PreSavingThrows =====
+	M = StageMods(ECombatEvent::PreSavingThrows);
+	Plan.FoldStage(ECombatEvent::PreSavingThrows, M, &Dice);
+
+	AP     += M.APDelta;
+	Damage += M.DamageDelta;
+
+	int32 ArmourNeed = CombatMath::ModifiedSaveNeed(T.Save, AP);
+	ArmourNeed = FMath::Clamp(ArmourNeed - (M.bIgnoreCover ? 0 : P.CoverSaveMod), 2, 7);
+
+	const int32 InvTN    = FMath::Clamp(T.Invuln + M.InvulnNeedOffset, 2, 7);
+	const int32 SaveNeed = (InvTN >= 2 && InvTN <= 6) ? FMath::Min(ArmourNeed, InvTN) : ArmourNeed;
+
+	const int32 NormalWounds = FMath::Max(0, Wounds - CritNoSave);
+	int32 Unsaved = NormalWounds;
+	if (SaveNeed <= 6)
+	{
+		Unsaved = NormalWounds - DiceKernel::RollAndCount(Dice, NormalWounds, SaveNeed, Rolls);
+	}
+	Unsaved += CritNoSave;
+
+	const int32 DamageRolled = Unsaved * Damage;
+	const int32 Visible      = (P.VisibleModels < 0) ? T.Models : FMath::Min(P.VisibleModels, T.Models);
+	const int32 Clamped      = FMath::Min(DamageRolled, Visible * FMath::Max(1, T.WoundsPerModel));
+
+	// ===== PostDamageCompute / FNP =====
+	M = StageMods(ECombatEvent::PostDamageCompute);
+	Plan.FoldStage(ECombatEvent::PostDamageCompute, M, &Dice);
+	const int32 FnpTN = FMath::Clamp(T.FeelNoPain + M.FnpNeedOffset, 2, 7);
+
+	int32 Final = Clamped;
+	if (Clamped > 0 && FnpTN <= 6)
+	{
+		Final = FMath::Max(0, Clamped - DiceKernel::RollAndCount(Dice, Clamped, FnpTN, Rolls));
+	}
+
+	// ===== PostResolveAttack =====
+	M = StageMods(ECombatEvent::PostResolveAttack);
+	// Attacker assumed at full health: each Hazardous 6 costs one whole model
+	const int32 WPM = FMath::Max(1, AttackerRow.Wounds);
+	const int32 Mortals = M.MortalDamageImmediateToOwner + Plan.RollHazardousSpill(Dice, Models, WPM, Models * WPM);
+
+	R.Attacks       = Attacks;
+	R.Hits          = Hits;
+	R.Wounds        = Wounds;
+	R.CritNoSave    = CritNoSave;
+	R.Unsaved       = Unsaved;
+	R.DamageRolled  = DamageRolled;
+	R.DamageClamped = Clamped;
+	R.FinalDamage   = Final;
+	R.MortalsToAttacker = Mortals;
+	return R;
+}
@@ -0,0 +1,76 @@
+// CombatSimulator.h
+#pragma once
+#include "CoreMinimal.h"
+#include "ArmyData.h"
+#include "CombatDice.h"
+#include "CombatEffects.h"
+#include "KeywordProcessor.h"
+
+// Defender side of a simulated attack (what AUnitBase would report via GetToughness/GetSave/...)
+struct FSimTargetStats
+{
+	int32 Toughness      = 4;
+	int32 Save           = 3;
+	int32 Invuln         = 7; // 2..6, 7 = none
+	int32 FeelNoPain     = 7; // 2..6, 7 = none
+	int32 WoundsPerModel = 1;
+	int32 Models         = 5;
+
+	TArray<FUnitModifier> Mods;
+
+	static FSimTargetStats FromRow(const FUnitRow& Row)
+	{
+		FSimTargetStats S;
+		S.Toughness      = Row.Toughness;
+		S.Save           = Row.Save;
+		S.Invuln         = Row.InvulnSave;
+		S.FeelNoPain     = Row.FeelNoPain;
+		S.WoundsPerModel = FMath::Max(1, Row.Wounds);
+		S.Models         = FMath::Max(0, Row.Models);
+		return S;
+	}
+};
+
+// Situational inputs the game mode would normally get from the world
+struct FSimAttackParams
+{
+	float RangeInches   = 12.f;
+	bool  bMoved        = false;
+	bool  bAdvanced     = false;
+	int32 CoverHitMod   = 0;   // as returned by QueryCover
+	int32 CoverSaveMod  = 0;
+	int32 VisibleModels = -1;  // -1 = all target models visible
+};
+
+struct FSimAttackResult
+{
+	int32 Attacks       = 0;
+	int32 Hits          = 0;
+	int32 Wounds        = 0;
+	int32 CritNoSave    = 0;
+	int32 Unsaved       = 0;
+	int32 DamageRolled  = 0;
+	int32 DamageClamped = 0;
+	int32 FinalDamage   = 0;   // after FNP
+	int32 MortalsToAttacker = 0; // Hazardous etc.
+};
+
+/**
+ * Actor-free copy of AMatchGameMode::ResolveRangedAttack_Internal's dice pipeline
+ * (hit -> wound -> save -> FNP, keyword plan and unit modifiers). No world, no traces, no timers.
+ * Modifiers are read-only here: uses/expiry are not consumed.
+ */
+class TABLETOP_API FCombatSimulator
+{
+public:
+	static FSimAttackResult Resolve(const FUnitRow& AttackerRow,
+									int32 AttackerModels,
+									const FWeaponProfile& Weapon,
+									const TArray<FUnitModifier>& AttackerMods,
+									const FSimTargetStats& Target,
+									const FSimAttackParams& Params,
+									FCombatDice& Dice);
+
+	// Same filter AUnitBase::CollectStageMods applies (stage + role)
+	static FRollModifiers CollectMods(const TArray<FUnitModifier>& Mods, ECombatEvent Stage, bool bAsAttacker);
+};
@@ -0,0 +1,286 @@
+#include "CombatBenchCommandlet.h"
+
+#include "Tabletop/CombatSimulator.h"
+#include "Tabletop/KeywordProcessor.h"
+#include "Tabletop/WeaponKeywords.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatBench, Log, All);
+
+namespace
+{
+	struct FBenchCase
+	{
+		const TCHAR* Name;
+		TArray<FWeaponKeywordData> Keywords;
+	};
+
+	FWeaponKeywordData KW(EWeaponKeyword Type, int32 Value = 0)
+	{
+		FWeaponKeywordData D;
+		D.Type  = Type;
+		D.Value = Value;
+		return D;
+	}
+
+	TArray<FBenchCase> BuildCases()
+	{
+		TArray<FBenchCase> C;
+		C.Add({ TEXT("Plain"),           {} });
+		C.Add({ TEXT("Heavy"),           { KW(EWeaponKeyword::Heavy) } });
+		C.Add({ TEXT("RapidFire 1"),     { KW(EWeaponKeyword::RapidFire, 1) } });
+		C.Add({ TEXT("Sustained 1"),     { KW(EWeaponKeyword::SustainedHits, 1) } });
+		C.Add({ TEXT("Lethal"),          { KW(EWeaponKeyword::LethalHits) } });
+		C.Add({ TEXT("Devastating"),     { KW(EWeaponKeyword::DevastatingWounds) } });
+		C.Add({ TEXT("Torrent"),         { KW(EWeaponKeyword::Torrent) } });
+		C.Add({ TEXT("Blast (D6)"),      { KW(EWeaponKeyword::Blast) } });
+		C.Add({ TEXT("Hazardous"),       { KW(EWeaponKeyword::Hazardous) } });
+		C.Add({ TEXT("IgnoresCover"),    { KW(EWeaponKeyword::IgnoresCover) } });
+		C.Add({ TEXT("Sus+Lethal+Dev"),  { KW(EWeaponKeyword::SustainedHits, 1), KW(EWeaponKeyword::LethalHits), KW(EWeaponKeyword::DevastatingWounds) } });
+		C.Add({ TEXT("Everything"),      { KW(EWeaponKeyword::Heavy), KW(EWeaponKeyword::RapidFire, 1), KW(EWeaponKeyword::SustainedHits, 2),
+										   KW(EWeaponKeyword::LethalHits), KW(EWeaponKeyword::DevastatingWounds), KW(EWeaponKeyword::Blast),
+										   KW(EWeaponKeyword::Hazardous), KW(EWeaponKeyword::IgnoresCover) } });
+		// Only the dead ApplyStage path ever read these; both sides must agree they do nothing live
+		C.Add({ TEXT("TwinLinked"),      { KW(EWeaponKeyword::TwinLinked) } });
+		C.Add({ TEXT("Shred"),           { KW(EWeaponKeyword::Shred) } });
+		C.Add({ TEXT("Piercing 1"),      { KW(EWeaponKeyword::Piercing, 1) } });
+		C.Add({ TEXT("Rending 1"),       { KW(EWeaponKeyword::Rending, 1) } });
+		C.Add({ TEXT("Brutal 1"),        { KW(EWeaponKeyword::Brutal, 1) } });
+		C.Add({ TEXT("Blast 2"),         { KW(EWeaponKeyword::Blast, 2) } });
+		return C;
+	}
+
+	// Keyword work per attack as the live path did it before FAttackPlan: inline Heavy / Rapid Fire in the GM,
+	// then each stage walks the weapon's keywords again. Kept only so the bench has a baseline. It has to
+	// land on the same checksum as PlanKeywordPass (same dice stream), so a rule drifting on either side shows up.
+	int64 LegacyKeywordPass(const FWeaponProfile& W, const FCompiledKeywordSet& K, const FAttackPlanSetup& S, int32 HitCrits, int32 WoundCrits, FCombatDice& Dice)
+	{
+		const int32 Models = FMath::Max(0, S.AttackerModels);
+		int32 Attacks = FMath::Max(0, W.Attacks) * Models;
+		int32 HitNeed = FMath::Clamp(W.SkillToHit, 2, 6);
+
+		// GM inline movement rules
+		if (K.Has(EWeaponKeyword::Heavy) && !S.bAttackerMoved) HitNeed = FMath::Clamp(HitNeed - 1, 2, 6);
+		const int32 RFX = K.Value(EWeaponKeyword::RapidFire);
+		if (RFX > 0 && S.RangeInches <= float(W.RangeInches) * 0.5f + KINDA_SMALL_NUMBER) Attacks += RFX * Models;
+
+		const bool bHalf = S.RangeInches <= FMath::Max(1.f, W.RangeInches * 0.5f);
+		FRollModifiers M;
+		int32 Hits = 0, AutoWounds = 0, CritNoSave = 0, Mortals = 0, Grants = 0;
+
+		for (const ECombatEvent Stage : { ECombatEvent::PreHitCalc, ECombatEvent::PostHitRolls, ECombatEvent::PreWoundCalc,
+										  ECombatEvent::PostWoundRolls, ECombatEvent::PreSavingThrows, ECombatEvent::PostResolveAttack })
+		{
+			for (const FWeaponKeywordData& KW : W.Keywords)
+			{
+				switch (KW.Type)
+				{
+					case EWeaponKeyword::Heavy:
+						if (Stage == ECombatEvent::PreHitCalc && !S.bAttackerMoved) M.HitNeedOffset -= 1;
+						break;
+					case EWeaponKeyword::RapidFire:
+						if (Stage == ECombatEvent::PreHitCalc && KW.Value > 0 && bHalf) M.AttacksDelta += KW.Value;
+						break;
+					case EWeaponKeyword::Blast:
+						// Blast X (Value > 0) was only read by the unused ApplyStage path
+						if (Stage == ECombatEvent::PreHitCalc && KW.Value == 0)
+						{
+							if (S.TargetModels >= 11)     M.AttacksDelta += Dice.D6();
+							else if (S.TargetModels >= 6) M.AttacksDelta += Dice.D3();
+						}
+						break;
+					case EWeaponKeyword::Torrent:
+						if (Stage == ECombatEvent::PreHitCalc) M.bAutoHit = true;
+						break;
+					case EWeaponKeyword::SustainedHits:
+						if (Stage == ECombatEvent::PostHitRolls && KW.Value > 0) Hits += HitCrits * KW.Value;
+						break;
+					case EWeaponKeyword::LethalHits:
+						if (Stage == ECombatEvent::PostHitRolls) AutoWounds += HitCrits;
+						break;
+					case EWeaponKeyword::DevastatingWounds:
+						if (Stage == ECombatEvent::PostWoundRolls) CritNoSave += WoundCrits;
+						break;
+					case EWeaponKeyword::IgnoresCover:
+						if (Stage == ECombatEvent::PreSavingThrows) M.bIgnoreCover = true;
+						break;
+					case EWeaponKeyword::Hazardous:
+						if (Stage == ECombatEvent::PostResolveAttack)
+						{
+							for (int32 i = 0; i < Models; ++i) if (Dice.D6() == 6) ++Mortals;
+						}
+						break;
+					case EWeaponKeyword::Suppressive:
+						if (Stage == ECombatEvent::PostResolveAttack) ++Grants;
+						break;
+					case EWeaponKeyword::TwinLinked:
+					case EWeaponKeyword::Shred:
+					case EWeaponKeyword::Piercing:
+					case EWeaponKeyword::Rending:
+					case EWeaponKeyword::Brutal:
+						// Still looked up every stage, but only GatherPassiveAndConditional/ApplyStage acted
+						// on these and neither was ever called - the live path ignored them
+						break;
+					default:
+						break;
+				}
+			}
+		}
+
+		return int64(Attacks + M.AttacksDelta) * 10000 + (HitNeed + M.HitNeedOffset) * 1000
+			 + Hits + AutoWounds + CritNoSave + Mortals + Grants
+			 + M.APDelta + M.DamageDelta + (M.bAutoHit ? 1 : 0) + (M.bIgnoreCover ? 1 : 0)
+			 + (M.bRerollAllWounds ? 1 : 0) + (M.bRerollOnesWounds ? 1 : 0);
+	}
+
+	int64 PlanKeywordPass(const FWeaponProfile& W, const FCompiledKeywordSet& K, const FAttackPlanSetup& S, int32 HitCrits, int32 WoundCrits, FCombatDice& Dice)
+	{
+		const FAttackPlan Plan = FAttackPlan::Build(W, K, S);
+
+		FRollModifiers M;
+		Plan.FoldStage(ECombatEvent::PreHitCalc, M, &Dice);
+		int32 Hits = 0, AutoWounds = 0, CritNoSave = 0;
+		Plan.ApplyHitCrits(HitCrits, Hits, AutoWounds);
+		Plan.FoldStage(ECombatEvent::PreWoundCalc, M, &Dice);
+		Plan.ApplyWoundCrits(WoundCrits, CritNoSave);
+		Plan.FoldStage(ECombatEvent::PreSavingThrows, M, &Dice);
+
+		const int32 Mortals = Plan.RollHazardousSpill(Dice, S.AttackerModels, 1, S.AttackerModels);
+		TArray<FUnitModifier> ToAttacker, ToTarget;
+		Plan.CollectGrants(1, ToAttacker, ToTarget);
+
+		return int64(Plan.Attacks + M.AttacksDelta) * 10000 + (Plan.HitNeed + M.HitNeedOffset) * 1000
+			 + Hits + AutoWounds + CritNoSave + Mortals + ToAttacker.Num() + ToTarget.Num()
+			 + M.APDelta + M.DamageDelta + (M.bAutoHit ? 1 : 0) + (M.bIgnoreCover ? 1 : 0)
+			 + (M.bRerollAllWounds ? 1 : 0) + (M.bRerollOnesWounds ? 1 : 0);
+	}
+}
+
+UCombatBenchCommandlet::UCombatBenchCommandlet()
+{
+	IsClient        = false;
+	IsServer        = false;
+	IsEditor        = false;
+	LogToConsole    = true;
+	ShowErrorCount  = true;
+}
+
+int32 UCombatBenchCommandlet::Main(const FString& Params)
+{
+	int32 Iters  = 200000;
+	int32 Seed   = 1234;
+	int32 Models = 10;
+	FParse::Value(*Params, TEXT("Iters="),  Iters);
+	FParse::Value(*Params, TEXT("Seed="),   Seed);
+	FParse::Value(*Params, TEXT("Models="), Models);
+	Iters  = FMath::Max(1, Iters);
+	Models = FMath::Max(1, Models);
+
+	// Marine-ish shooters into a 10-model T4 3+ squad in light cover
+	FUnitRow Attacker;
+	Attacker.Models = Models;
+	Attacker.Wounds = 2;
+
+	FWeaponProfile Weapon;
+	Weapon.WeaponId    = TEXT("Bench");
+	Weapon.RangeInches = 24;
+	Weapon.Attacks     = 2;
+	Weapon.SkillToHit  = 3;
+	Weapon.Strength    = 4;
+	Weapon.AP          = 1;
+	Weapon.Damage      = 1;
+
+	FSimTargetStats Target;
+	Target.Toughness      = 4;
+	Target.Save           = 3;
+	Target.Invuln         = 7;
+	Target.FeelNoPain     = 6;
+	Target.WoundsPerModel = 2;
+	Target.Models         = 10;
+
+	FSimAttackParams P;
+	P.RangeInches  = 10.f;
+	P.CoverSaveMod = 1;
+
+	// One attacker buff, one defender debuff, so the modifier path is exercised
+	TArray<FUnitModifier> AttackerMods;
+	{
+		FUnitModifier Aim;
+		Aim.AppliesAt = ECombatEvent::PreHitCalc;
+		Aim.Targeting = EModifierTarget::OwnerWhenAttacking;
+		Aim.Mods.HitNeedOffset = -1;
+		AttackerMods.Add(Aim);
+	}
+	{
+		FUnitModifier Brace;
+		Brace.AppliesAt = ECombatEvent::PreSavingThrows;
+		Brace.Targeting = EModifierTarget::OwnerWhenDefending;
+		Brace.Mods.InvulnNeedOffset = -1;
+		Target.Mods.Add(Brace);
+	}
+
+	UE_LOG(LogCombatBench, Display, TEXT("CombatBench: %d iterations per case, seed %d, %d attacking models"), Iters, Seed, Models);
+	UE_LOG(LogCombatBench, Display, TEXT("%-16s %14s %12s %10s"), TEXT("Case"), TEXT("resolutions/s"), TEXT("ns/resolve"), TEXT("avg dmg"));
+
+	for (const FBenchCase& Case : BuildCases())
+	{
+		Weapon.Keywords = Case.Keywords;
+
+		FCombatDice Dice(FMatchDiceService::DeriveSubstreamSeed(Seed, 0));
+		int64 TotalDamage = 0;
+
+		const double T0 = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iters; ++i)
+		{
+			const FSimAttackResult R = FCombatSimulator::Resolve(Attacker, Models, Weapon, AttackerMods, Target, P, Dice);
+			TotalDamage += R.FinalDamage;
+		}
+		const double Secs = FMath::Max(FPlatformTime::Seconds() - T0, 1e-9);
+
+		UE_LOG(LogCombatBench, Display, TEXT("%-16s %14.0f %12.1f %10.2f"),
+			Case.Name, Iters / Secs, Secs * 1e9 / Iters, double(TotalDamage) / Iters);
+	}
+
+
+	// Keyword derivation only (no to-hit/wound/save dice): per-stage lookups vs plan build + execute
+	FAttackPlanSetup Setup;
+	Setup.AttackerModels  = Models;
+	Setup.TargetModels    = Target.Models;
+	Setup.TargetToughness = Target.Toughness;
+	Setup.RangeInches     = P.RangeInches;
+
+	UE_LOG(LogCombatBench, Display, TEXT(""));
+	UE_LOG(LogCombatBench, Display, TEXT("%-16s %14s %14s %8s"), TEXT("Keywords"), TEXT("per-stage ns"), TEXT("plan ns"), TEXT("speedup"));
+
+	for (const FBenchCase& Case : BuildCases())
+	{
+		Weapon.Keywords = Case.Keywords;
+		const FCompiledKeywordSet Compiled = FCompiledKeywordSet::Build(Weapon.Keywords); // units cache this
+
+		int64 LegacyCheck = 0, PlanCheck = 0;
+
+		FCombatDice LegacyDice(FMatchDiceService::DeriveSubstreamSeed(Seed, 1));
+		double T0 = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iters; ++i)
+		{
+			LegacyCheck += LegacyKeywordPass(Weapon, Compiled, Setup, 3, 2, LegacyDice);
+		}
+		const double LegacySecs = FMath::Max(FPlatformTime::Seconds() - T0, 1e-9);
+
+		FCombatDice PlanDice(FMatchDiceService::DeriveSubstreamSeed(Seed, 1));
+		T0 = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iters; ++i)
+		{
+			PlanCheck += PlanKeywordPass(Weapon, Compiled, Setup, 3, 2, PlanDice);
+		}
+		const double PlanSecs = FMath::Max(FPlatformTime::Seconds() - T0, 1e-9);
+
+		if (LegacyCheck != PlanCheck)
+		{
+			UE_LOG(LogCombatBench, Warning, TEXT("%s: plan and per-stage pass disagree (%lld vs %lld)"), Case.Name, PlanCheck, LegacyCheck);
+		}
+		UE_LOG(LogCombatBench, Display, TEXT("%-16s %14.1f %14.1f %7.2fx"),
+			Case.Name, LegacySecs * 1e9 / Iters, PlanSecs * 1e9 / Iters, LegacySecs / PlanSecs);
+	}
+
+	return 0;
+}
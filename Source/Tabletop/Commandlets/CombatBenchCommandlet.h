@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatBenchCommandlet.generated.h"
+
+/**
+ * Headless combat throughput benchmark.
+ *   UnrealEditor-Cmd <Project> -run=CombatBench [-Iters=200000] [-Seed=1234] [-Models=10]
+ * Runs FCombatSimulator over a matrix of weapon keyword sets and logs resolutions/sec,
+ * then times keyword derivation alone: the old per-stage lookups vs FAttackPlan build + execute.
+ */
+UCLASS()
+class TABLETOP_API UCombatBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCombatBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,382 @@
+#include "CoverBakeCommandlet.h"
+
+#include "Components/BoxComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/DataTable.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#include "Tabletop/CoverBakeData.h"
+#include "Tabletop/MapData.h"
+#include "Tabletop/Actors/CoverVolume.h"
+#include "Tabletop/Actors/DeploymentZone.h"
+#include "Tabletop/Actors/ObjectiveMarker.h"
+#include "Tabletop/Gamemodes/MatchGameMode.h" // FCoverPresetRow
+
+DEFINE_LOG_CATEGORY_STATIC(LogCoverBake, Log, All);
+
+#if WITH_EDITOR
+namespace
+{
+	struct FBakeSettings
+	{
+		float CellInches = 1.f;
+		float VisInches  = 3.f;
+		float CmPerInch  = 50.8f;
+		TArray<const UStaticMesh*> PresetMeshes;
+	};
+
+	// One level's actors and where its streaming transform puts them in the persistent world
+	struct FBakeLevel
+	{
+		const ULevel* Level = nullptr;
+		FTransform    LevelToWorld = FTransform::Identity;
+	};
+
+	template<typename T, typename FuncType>
+	void ForEachBakeActor(TConstArrayView<FBakeLevel> Levels, FuncType&& Func)
+	{
+		for (const FBakeLevel& L : Levels)
+		{
+			for (AActor* A : L.Level->Actors)
+			{
+				if (T* Typed = Cast<T>(A)) Func(Typed, L.LevelToWorld);
+			}
+		}
+	}
+
+	// Everything this volume could block with, now or after a preset swap
+	FBox2D CoverFootprint(const ACoverVolume* CV, const FBakeSettings& S, const FTransform& LevelToWorld)
+	{
+		FBox B(ForceInit);
+		if (CV->Box) B += CV->Box->Bounds.GetBox();
+		if (CV->Visual)
+		{
+			if (CV->Visual->GetStaticMesh()) B += CV->Visual->Bounds.GetBox();
+
+			const FTransform& VT = CV->Visual->GetComponentTransform();
+			for (const UStaticMesh* M : { (const UStaticMesh*)CV->HighMesh, (const UStaticMesh*)CV->LowMesh })
+			{
+				if (M) B += M->GetBounds().GetBox().TransformBy(VT);
+			}
+			for (const UStaticMesh* M : S.PresetMeshes)
+			{
+				B += M->GetBounds().GetBox().TransformBy(VT);
+			}
+		}
+		if (!B.IsValid) return FBox2D(ForceInit);
+		B = B.TransformBy(LevelToWorld); // a rotated sublevel only grows the box, which is still conservative
+		return FBox2D(FVector2D(B.Min), FVector2D(B.Max));
+	}
+
+	UTabletopCoverBakeData* BakeLevels(TConstArrayView<FBakeLevel> Levels, UObject* Outer, FName AssetName, const FBakeSettings& S)
+	{
+		UTabletopCoverBakeData* Bake = NewObject<UTabletopCoverBakeData>(Outer, AssetName, RF_Public | RF_Standalone);
+		Bake->CmPerInch  = S.CmPerInch;
+		Bake->CellSizeCm = S.CellInches * S.CmPerInch;
+		Bake->VisStride  = FMath::Max(1, FMath::RoundToInt(S.VisInches / S.CellInches));
+
+		// Board extent: covers, deployment zones and objectives, padded a few inches
+		// The registry matches live covers to baked ones by actor name, so a name reused across sublevels can't be baked
+		FBox Board(ForceInit);
+		TSet<FName> Names;
+		bool bDuplicateName = false;
+		ForEachBakeActor<ACoverVolume>(Levels, [&](const ACoverVolume* CV, const FTransform& LevelToWorld)
+		{
+			const FBox2D F = CoverFootprint(CV, S, LevelToWorld);
+			if (!F.bIsValid) return;
+
+			bool bSeen = false;
+			Names.Add(CV->GetFName(), &bSeen);
+			if (bSeen)
+			{
+				UE_LOG(LogCoverBake, Error, TEXT("  cover name %s is used in more than one level; rename it and rebake"), *CV->GetName());
+				bDuplicateName = true;
+			}
+
+			FBakedCover& C = Bake->Covers.AddDefaulted_GetRef();
+			C.ActorName = CV->GetFName();
+			C.Footprint = F;
+			Board += FBox(FVector(F.Min, 0.f), FVector(F.Max, 0.f));
+		});
+		ForEachBakeActor<ADeploymentZone>(Levels, [&Board](const ADeploymentZone* Z, const FTransform& LevelToWorld)
+		{
+			Board += Z->GetComponentsBoundingBox(true).TransformBy(LevelToWorld);
+		});
+		ForEachBakeActor<AObjectiveMarker>(Levels, [&Board](const AObjectiveMarker* M, const FTransform& LevelToWorld)
+		{
+			Board += M->GetComponentsBoundingBox(true).TransformBy(LevelToWorld);
+		});
+
+		if (bDuplicateName) return nullptr;
+		if (!Board.IsValid || Bake->Covers.Num() >= UTabletopCoverBakeData::NoCover)
+		{
+			UE_LOG(LogCoverBake, Warning, TEXT("  nothing to bake (covers=%d)"), Bake->Covers.Num());
+			return nullptr;
+		}
+		Board = Board.ExpandBy(FVector(6.f * S.CmPerInch, 6.f * S.CmPerInch, 0.f));
+
+		const float Cell = Bake->CellSizeCm;
+		const int32 Stride = Bake->VisStride;
+		Bake->Origin  = FVector2D(Board.Min);
+		Bake->VisDims = FIntPoint(FMath::CeilToInt((Board.Max.X - Board.Min.X) / (Cell * Stride)),
+		                          FMath::CeilToInt((Board.Max.Y - Board.Min.Y) / (Cell * Stride)));
+		Bake->Dims    = Bake->VisDims * Stride;
+
+		// ---- fine grid: nearest footprint + clearance from the cell centre ----
+		const int32 N = Bake->Dims.X * Bake->Dims.Y;
+		Bake->NearestCover.Init(UTabletopCoverBakeData::NoCover, N);
+		Bake->ClearanceCm.Init(UTabletopCoverBakeData::MaxClearance, N);
+
+		for (int32 y = 0; y < Bake->Dims.Y; ++y)
+		{
+			for (int32 x = 0; x < Bake->Dims.X; ++x)
+			{
+				const FVector2D P = Bake->Origin + FVector2D((x + 0.5f) * Cell, (y + 0.5f) * Cell);
+				float Best2 = TNumericLimits<float>::Max();
+				int32 BestIdx = INDEX_NONE;
+				for (int32 c = 0; c < Bake->Covers.Num(); ++c)
+				{
+					const float D2 = (float)Bake->Covers[c].Footprint.ComputeSquaredDistanceToPoint(P);
+					if (D2 < Best2) { Best2 = D2; BestIdx = c; }
+				}
+
+				const int32 Idx = y * Bake->Dims.X + x;
+				if (BestIdx == INDEX_NONE) continue;
+				Bake->NearestCover[Idx] = (uint16)BestIdx;
+				Bake->ClearanceCm[Idx]  = (uint16)FMath::Min<float>(FMath::FloorToFloat(FMath::Sqrt(Best2)), UTabletopCoverBakeData::MaxClearance);
+			}
+		}
+
+		// ---- vis grid ----
+		// Every segment between two square cells lies in their convex hull, which is the centre-to-centre segment swept
+		// by the cell square. So "segment misses footprint grown by half a cell" proves every model-to-model ray misses it.
+		const int32 VisN = Bake->VisDims.X * Bake->VisDims.Y;
+		Bake->VisClearBits.Init(0u, FMath::DivideAndRoundUp(VisN * VisN, 32));
+
+		const float VisCm = Cell * Stride;
+		const float Half  = VisCm * 0.5f;
+		TArray<FBox> Grown;
+		for (const FBakedCover& C : Bake->Covers)
+		{
+			Grown.Add(FBox(FVector(C.Footprint.Min - FVector2D(Half), -1.f), FVector(C.Footprint.Max + FVector2D(Half), 1.f)));
+		}
+
+		auto VisCentre = [&](int32 V)
+		{
+			return FVector(Bake->Origin.X + ((V % Bake->VisDims.X) + 0.5f) * VisCm,
+			               Bake->Origin.Y + ((V / Bake->VisDims.X) + 0.5f) * VisCm, 0.f);
+		};
+
+		int32 ClearPairs = 0;
+		for (int32 a = 0; a < VisN; ++a)
+		{
+			const FVector A = VisCentre(a);
+			for (int32 b = a; b < VisN; ++b)
+			{
+				const FVector B = VisCentre(b);
+				const FVector D = B - A;
+				bool bClear = true;
+				for (const FBox& G : Grown)
+				{
+					const bool bHit = (a == b) ? G.IsInsideOrOn(A) : FMath::LineBoxIntersection(G, A, B, D);
+					if (bHit) { bClear = false; break; }
+				}
+				if (!bClear) continue;
+
+				Bake->SetVisClear(a, b);
+				Bake->SetVisClear(b, a);
+				ClearPairs += (a == b) ? 1 : 2;
+			}
+		}
+
+		UE_LOG(LogCoverBake, Display, TEXT("  %d covers, %dx%d cells (%.0f cm), %dx%d vis cells, %.1f%% vis pairs clear"),
+			Bake->Covers.Num(), Bake->Dims.X, Bake->Dims.Y, Cell, Bake->VisDims.X, Bake->VisDims.Y,
+			VisN > 0 ? 100.f * ClearPairs / float(VisN * VisN) : 0.f);
+		return Bake;
+	}
+
+	// Loads a map/sublevel package and registers its components; only need transforms/bounds, the bake is purely geometric
+	UWorld* LoadBakeWorld(const FString& PackageName)
+	{
+		UPackage* Pkg = LoadPackage(nullptr, *PackageName, LOAD_None);
+		UWorld* World = Pkg ? UWorld::FindWorldInPackage(Pkg) : nullptr;
+		if (!World) return nullptr;
+
+		World->WorldType = EWorldType::Editor;
+		World->AddToRoot();
+		if (!World->bIsWorldInitialized)
+		{
+			World->InitWorld(UWorld::InitializationValues()
+				.AllowAudioPlayback(false)
+				.CreatePhysicsScene(false)
+				.CreateNavigation(false)
+				.CreateAISystem(false)
+				.ShouldSimulatePhysics(false)
+				.EnableTraceCollision(false));
+		}
+		World->UpdateWorldComponents(true, false);
+		return World;
+	}
+
+	void ReleaseBakeWorld(UWorld* World)
+	{
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+	}
+
+	bool BakeMap(const FString& MapPath, const FBakeSettings& S)
+	{
+		const FString LongName = FPackageName::ObjectPathToPackageName(MapPath);
+		UWorld* World = LoadBakeWorld(LongName);
+		if (!World)
+		{
+			UE_LOG(LogCoverBake, Error, TEXT("Could not load map %s"), *MapPath);
+			return false;
+		}
+
+		// World Partition keeps actors in external packages that this loader never sees; a bake missing them would
+		// only be thrown away by the registry at runtime, so don't write one
+		if (World->IsPartitionedWorld())
+		{
+			UE_LOG(LogCoverBake, Warning, TEXT("Skipping %s: World Partition maps aren't supported by the cover bake"), *LongName);
+			ReleaseBakeWorld(World);
+			CollectGarbage(RF_NoFlags);
+			return true;
+		}
+
+		UE_LOG(LogCoverBake, Display, TEXT("Baking %s"), *LongName);
+
+		// Persistent level plus every streaming sublevel, each placed by its streaming transform.
+		// Always-loaded or streamed in later doesn't matter: covers that aren't present yet can't block anything.
+		TArray<FBakeLevel> Levels;
+		Levels.Add({ World->PersistentLevel, FTransform::Identity });
+
+		TArray<UWorld*> SubWorlds;
+		bool bSublevelsOk = true;
+		for (const ULevelStreaming* SL : World->GetStreamingLevels())
+		{
+			if (!SL) continue;
+			const FString SubName = SL->GetWorldAssetPackageName();
+			UWorld* Sub = LoadBakeWorld(SubName);
+			if (!Sub)
+			{
+				UE_LOG(LogCoverBake, Error, TEXT("  could not load sublevel %s"), *SubName);
+				bSublevelsOk = false;
+				continue;
+			}
+			SubWorlds.Add(Sub);
+			Levels.Add({ Sub->PersistentLevel, SL->LevelTransform });
+			UE_LOG(LogCoverBake, Display, TEXT("  + sublevel %s"), *SubName);
+		}
+
+		const FString MapName = FPackageName::GetShortName(LongName);
+		const FString BakePkgName = UTabletopCoverBakeData::PackagePathForMap(MapName);
+		UPackage* BakePkg = CreatePackage(*BakePkgName);
+		BakePkg->FullyLoad();
+
+		// A bake missing a sublevel's covers would be distrusted as soon as they stream in; fail instead
+		bool bOk = false;
+		if (!bSublevelsOk)
+		{
+			UE_LOG(LogCoverBake, Error, TEXT("  not baked: a sublevel failed to load"));
+		}
+		else if (UTabletopCoverBakeData* Bake = BakeLevels(Levels, BakePkg, FName(*(MapName + TEXT("_CoverBake"))), S))
+		{
+			BakePkg->MarkPackageDirty();
+			const FString File = FPackageName::LongPackageNameToFilename(BakePkgName, FPackageName::GetAssetPackageExtension());
+
+			FSavePackageArgs Args;
+			Args.TopLevelFlags = RF_Public | RF_Standalone;
+			bOk = UPackage::SavePackage(BakePkg, Bake, *File, Args);
+			UE_LOG(LogCoverBake, Display, TEXT("  -> %s (%s)"), *File, bOk ? TEXT("saved") : TEXT("SAVE FAILED"));
+		}
+
+		for (UWorld* Sub : SubWorlds) ReleaseBakeWorld(Sub);
+		ReleaseBakeWorld(World);
+		CollectGarbage(RF_NoFlags);
+		return bOk;
+	}
+}
+#endif // WITH_EDITOR
+
+UCoverBakeCommandlet::UCoverBakeCommandlet()
+{
+	IsClient        = false;
+	IsServer        = false;
+	IsEditor        = true;
+	LogToConsole    = true;
+	ShowErrorCount  = true;
+}
+
+int32 UCoverBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FBakeSettings S;
+	FParse::Value(*Params, TEXT("CellInches="), S.CellInches);
+	FParse::Value(*Params, TEXT("VisInches="),  S.VisInches);
+	FParse::Value(*Params, TEXT("CmPerInch="),  S.CmPerInch);
+	S.CellInches = FMath::Max(0.25f, S.CellInches);
+	S.VisInches  = FMath::Max(S.CellInches, S.VisInches);
+
+	FString PresetsPath;
+	if (FParse::Value(*Params, TEXT("Presets="), PresetsPath))
+	{
+		if (const UDataTable* Presets = LoadObject<UDataTable>(nullptr, *PresetsPath))
+		{
+			Presets->ForeachRow<FCoverPresetRow>(TEXT("CoverBake"), [&S](const FName&, const FCoverPresetRow& Row)
+			{
+				if (Row.HighCoverMesh) S.PresetMeshes.AddUnique(Row.HighCoverMesh);
+				if (Row.LowCoverMesh)  S.PresetMeshes.AddUnique(Row.LowCoverMesh);
+			});
+		}
+		else
+		{
+			UE_LOG(LogCoverBake, Warning, TEXT("Could not load preset table %s; footprints use the placed meshes only"), *PresetsPath);
+		}
+	}
+
+	TArray<FString> Maps;
+	FString MapTablePath, SingleMap;
+	if (FParse::Value(*Params, TEXT("MapTable="), MapTablePath))
+	{
+		if (const UDataTable* MapTable = LoadObject<UDataTable>(nullptr, *MapTablePath))
+		{
+			MapTable->ForeachRow<FMapRow>(TEXT("CoverBake"), [&Maps](const FName&, const FMapRow& Row)
+			{
+				const FString Path = !Row.Level.IsNull() ? Row.Level.ToSoftObjectPath().GetAssetPathString() : Row.LevelName.ToString();
+				if (!Path.IsEmpty()) Maps.AddUnique(Path);
+			});
+		}
+		else
+		{
+			UE_LOG(LogCoverBake, Error, TEXT("Could not load map table %s"), *MapTablePath);
+		}
+	}
+	if (FParse::Value(*Params, TEXT("Map="), SingleMap)) Maps.AddUnique(SingleMap);
+
+	if (Maps.Num() == 0)
+	{
+		UE_LOG(LogCoverBake, Error, TEXT("CoverBake: no maps (pass -MapTable=<FMapRow table> and/or -Map=<level path>)"));
+		return 1;
+	}
+
+	UE_LOG(LogCoverBake, Display, TEXT("CoverBake: %d map(s), %.2f\" cells, %.2f\" vis cells, %.1f cm/inch, %d preset meshes"),
+		Maps.Num(), S.CellInches, S.VisInches, S.CmPerInch, S.PresetMeshes.Num());
+
+	int32 Failed = 0;
+	for (const FString& Map : Maps)
+	{
+		if (!BakeMap(Map, S)) ++Failed;
+	}
+	return Failed == 0 ? 0 : 1;
+#else
+	UE_LOG(LogCoverBake, Error, TEXT("CoverBake needs an editor build"));
+	return 1;
+#endif
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CoverBakeCommandlet.generated.h"
+
+/**
+ * Bakes the per-map cover grid (UTabletopCoverBakeData) the cover registry loads at runtime.
+ *   UnrealEditor-Cmd <Project> -run=CoverBake -MapTable=/Game/Data/DT_Maps [-Map=/Game/Maps/TT_Map01]
+ *       [-Presets=/Game/Data/DT_CoverPresets] [-CellInches=1] [-VisInches=3] [-CmPerInch=50.8]
+ * Maps come from every FMapRow in -MapTable (plus any -Map). -Presets widens each cover's footprint by every preset mesh
+ * so faction presets applied at match start don't invalidate the bake. Output: /Game/CoverBakes/<Map>_CoverBake.
+ * The persistent level and every streaming sublevel (at its level transform) go into one bake; cover names must be
+ * unique across them. World Partition maps are skipped.
+ */
+UCLASS()
+class TABLETOP_API UCoverBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCoverBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,89 @@
+#include "CoverBakeData.h"
+
+void UTabletopCoverBakeData::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	int32 Version = PackedVersion;
+	Ar << Version;
+	if (Ar.IsLoading() && Version != PackedVersion)
+	{
+		// Old layout; leave the arrays empty so IsValidBake() fails and we fall back to traces until rebaked
+		NearestCover.Reset(); ClearanceCm.Reset(); VisClearBits.Reset();
+		return;
+	}
+
+	NearestCover.BulkSerialize(Ar);
+	ClearanceCm.BulkSerialize(Ar);
+	VisClearBits.BulkSerialize(Ar);
+}
+
+bool UTabletopCoverBakeData::IsValidBake() const
+{
+	const int32 N    = Dims.X * Dims.Y;
+	const int32 VisN = VisDims.X * VisDims.Y;
+	return N > 0 && CellSizeCm > KINDA_SMALL_NUMBER && VisStride > 0
+		&& NearestCover.Num() == N && ClearanceCm.Num() == N
+		&& VisClearBits.Num() == FMath::DivideAndRoundUp(VisN * VisN, 32);
+}
+
+int32 UTabletopCoverBakeData::CellIndex(const FVector& P) const
+{
+	const int32 X = FMath::FloorToInt((P.X - Origin.X) / CellSizeCm);
+	const int32 Y = FMath::FloorToInt((P.Y - Origin.Y) / CellSizeCm);
+	if (X < 0 || Y < 0 || X >= Dims.X || Y >= Dims.Y) return INDEX_NONE;
+	return Y * Dims.X + X;
+}
+
+int32 UTabletopCoverBakeData::VisCellIndex(const FVector& P) const
+{
+	const float VisCm = CellSizeCm * VisStride;
+	const int32 X = FMath::FloorToInt((P.X - Origin.X) / VisCm);
+	const int32 Y = FMath::FloorToInt((P.Y - Origin.Y) / VisCm);
+	if (X < 0 || Y < 0 || X >= VisDims.X || Y >= VisDims.Y) return INDEX_NONE;
+	return Y * VisDims.X + X;
+}
+
+float UTabletopCoverBakeData::ClearanceLowerBound(const FVector& P) const
+{
+	const int32 Idx = CellIndex(P);
+	if (Idx == INDEX_NONE || !ClearanceCm.IsValidIndex(Idx)) return -1.f;
+
+	// Baked at the cell centre; P is at most half a diagonal away from it
+	const float HalfDiag = CellSizeCm * UE_HALF_SQRT_2;
+	return FMath::Max(0.f, float(ClearanceCm[Idx]) - HalfDiag);
+}
+
+const FBakedCover* UTabletopCoverBakeData::NearestCoverAt(const FVector& P) const
+{
+	const int32 Idx = CellIndex(P);
+	if (Idx == INDEX_NONE || !NearestCover.IsValidIndex(Idx)) return nullptr;
+	const uint16 C = NearestCover[Idx];
+	return (C != NoCover && Covers.IsValidIndex(C)) ? &Covers[C] : nullptr;
+}
+
+bool UTabletopCoverBakeData::IsSegmentClear(const FVector& A, const FVector& B) const
+{
+	const int32 VA = VisCellIndex(A);
+	const int32 VB = VisCellIndex(B);
+	if (VA == INDEX_NONE || VB == INDEX_NONE) return false;
+
+	const int32 Bit = VA * (VisDims.X * VisDims.Y) + VB;
+	return VisClearBits.IsValidIndex(Bit >> 5) && (VisClearBits[Bit >> 5] & (1u << (Bit & 31))) != 0;
+}
+
+void UTabletopCoverBakeData::SetVisClear(int32 VA, int32 VB)
+{
+	const int32 Bit = VA * (VisDims.X * VisDims.Y) + VB;
+	VisClearBits[Bit >> 5] |= (1u << (Bit & 31));
+}
+
+FString UTabletopCoverBakeData::PackagePathForMap(const FString& MapShortName)
+{
+	return FString::Printf(TEXT("/Game/CoverBakes/%s_CoverBake"), *MapShortName);
+}
+
+FString UTabletopCoverBakeData::ObjectPathForMap(const FString& MapShortName)
+{
+	return FString::Printf(TEXT("%s.%s_CoverBake"), *PackagePathForMap(MapShortName), *MapShortName);
+}
@@ -0,0 +1,71 @@
+// CoverBakeData.h
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CoverBakeData.generated.h"
+
+// One cover volume as it stood when the map was baked
+USTRUCT()
+struct FBakedCover
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere) FName ActorName;
+
+	// XY bounds of everything this volume can ever block with (box + visual + any preset mesh); conservative by design
+	UPROPERTY(VisibleAnywhere) FBox2D Footprint = FBox2D(ForceInit);
+};
+
+/**
+ * Per-map cover grid written by the CoverBake commandlet, loaded by the cover registry when the level starts.
+ *   - fine cells (tabletop inches): nearest cover + clearance from the cell centre to its footprint
+ *   - coarse vis cells: bit set when no cover footprint can touch ANY segment between the two cells
+ * Cover only ever loses collision at runtime (damage / destroy), so "clear" answers stay true;
+ * anything that could grow a footprint makes the registry stop trusting the bake (see UTabletopCoverRegistrySubsystem).
+ */
+UCLASS()
+class TABLETOP_API UTabletopCoverBakeData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr uint16 NoCover      = 0xFFFF;
+	static constexpr uint16 MaxClearance = 0xFFFE; // clamp; "at least this far"
+
+	UPROPERTY(VisibleAnywhere, Category="Grid") FVector2D Origin = FVector2D::ZeroVector;
+	UPROPERTY(VisibleAnywhere, Category="Grid") float     CellSizeCm = 50.8f;
+	UPROPERTY(VisibleAnywhere, Category="Grid") FIntPoint Dims = FIntPoint::ZeroValue;
+	UPROPERTY(VisibleAnywhere, Category="Grid") int32     VisStride = 3;  // fine cells per vis cell side
+	UPROPERTY(VisibleAnywhere, Category="Grid") FIntPoint VisDims = FIntPoint::ZeroValue;
+	UPROPERTY(VisibleAnywhere, Category="Grid") float     CmPerInch = 50.8f; // scale it was baked at (info only; grid is in cm)
+
+	UPROPERTY(VisibleAnywhere, Category="Covers") TArray<FBakedCover> Covers;
+
+	// Packed per-cell data; bulk-serialized in Serialize() rather than as tagged properties
+	TArray<uint16> NearestCover; // Dims.X*Dims.Y, index into Covers or NoCover
+	TArray<uint16> ClearanceCm;  // Dims.X*Dims.Y
+	TArray<uint32> VisClearBits; // (VisN*VisN) bits, VisN = VisDims.X*VisDims.Y
+
+	virtual void Serialize(FArchive& Ar) override;
+
+	bool IsValidBake() const;
+
+	int32 CellIndex(const FVector& P) const;    // INDEX_NONE outside the grid
+	int32 VisCellIndex(const FVector& P) const; // INDEX_NONE outside the grid
+
+	// Lower bound on the XY distance from P to any baked cover footprint (< 0 = outside the grid / unknown)
+	float ClearanceLowerBound(const FVector& P) const;
+
+	const FBakedCover* NearestCoverAt(const FVector& P) const;
+
+	// True only if no baked footprint can intersect the A->B segment
+	bool IsSegmentClear(const FVector& A, const FVector& B) const;
+
+	void SetVisClear(int32 VA, int32 VB);
+
+	static FString PackagePathForMap(const FString& MapShortName); // /Game/CoverBakes/<Map>_CoverBake
+	static FString ObjectPathForMap(const FString& MapShortName);
+
+private:
+	static constexpr int32 PackedVersion = 1;
+};
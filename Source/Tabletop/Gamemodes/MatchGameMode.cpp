@@ -24,25 +24,24 @@
 #include "Tabletop/WeaponKeywords.h"
 #include "Tabletop/CombatEffects.h"
 #include "Tabletop/KeywordProcessor.h"
+#include "Tabletop/TabletopCoverRegistrySubsystem.h"
+#include "Tabletop/TabletopPushModel.h"
+#include "Tabletop/TabletopSpatialIndexSubsystem.h"
 #include "Tabletop/UnitActionResourceComponent.h"
 #include "Tabletop/WeaponKeywordHelpers.h"
 #include "Tabletop/Actors/UnitAction.h"
 
+DECLARE_STATS_GROUP(TEXT("TabletopCover"), STATGROUP_TabletopCover, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cover cache hits"),    STAT_CoverCacheHits,    STATGROUP_TabletopCover);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cover cache misses"),  STAT_CoverCacheMisses,  STATGROUP_TabletopCover);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cover traces saved"),  STAT_CoverTracesSaved,  STATGROUP_TabletopCover);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cover cache entries"),     STAT_CoverCacheEntries, STATGROUP_TabletopCover);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug draw RPCs"),         STAT_TabletopDebugDrawRPCs,  STATGROUP_TabletopNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug draw prims"),        STAT_TabletopDebugDrawPrims, STATGROUP_TabletopNet);
 
 namespace
 {
-    FORCEINLINE int32 D6() { return FMath::RandRange(1, 6); }
-
-    // 40k to-wound threshold from S vs T
-    FORCEINLINE int32 ToWoundTarget(int32 S, int32 T)
-    {
-        if (S >= 2*T)     return 2;
-        if (S >  T)       return 3;
-        if (S == T)       return 4;
-        if (2*S <= T)     return 6;
-        /* S < T */       return 5;
-    }
-
     // 40k: worsen the save by AP (AP 0→no change, AP 2 → +2 to needed roll)
     // clamp to [2..7]; 7 means "no save" (auto-fail)
     FORCEINLINE int32 ModifiedSaveNeed(int32 BaseSave, int32 AP)
@@ -56,13 +55,9 @@ namespace
 static void GetTargetModelHitPoints(const AUnitBase* Target, TArray<FVector>& Out)
 {
 	Out.Reset();
-	for (UStaticMeshComponent* TC : Target->ModelMeshes)
+	for (int32 j = 0; j < Target->GetNumModelVisuals(); ++j)
 	{
-		if (!IsValid(TC)) continue;
-		if (TC->DoesSocketExist(Target->ImpactSocketName))
-			Out.Add(TC->GetSocketTransform(Target->ImpactSocketName, RTS_World).GetLocation());
-		else
-			Out.Add(TC->GetComponentTransform().TransformPosition(Target->ImpactOffsetLocal));
+		Out.Add(Target->GetModelImpactPoint(j));
 	}
 	if (Out.Num() == 0) Out.Add(Target->GetActorLocation());
 }
@@ -72,22 +67,10 @@ static void CollectCoverVolumes_AllLevels(UWorld* W, TArray<ACoverVolume*>& Out,
 	Out.Reset();
 	if (!W) return;
 
-	// Persistent level
-	if (ULevel* PL = W->PersistentLevel)
+	// Covers join the registry on BeginPlay (persistent + streamed levels alike) and leave on EndPlay
+	if (const UTabletopCoverRegistrySubsystem* Registry = UTabletopCoverRegistrySubsystem::Get(W))
 	{
-		for (AActor* A : PL->Actors)
-			if (auto* CV = Cast<ACoverVolume>(A)) Out.Add(CV);
-	}
-
-	// Streaming levels that are currently loaded (and ideally visible)
-	for (ULevel* L : W->GetLevels())
-	{
-		if (!L || L == W->PersistentLevel) continue;
-		const bool bLoaded  = (L->bIsVisible || L->IsPersistentLevel()); // UE5 visibility is enough for actors to be spawned
-		if (!bLoaded) continue;
-
-		for (AActor* A : L->Actors)
-			if (auto* CV = Cast<ACoverVolume>(A)) Out.Add(CV);
+		Registry->GetAllCovers(Out);
 	}
 
 	if (bLog)
@@ -110,9 +93,8 @@ static void BuildImpactSites_Server(const AUnitBase* Attacker, const AUnitBase*
 
     // Pre-read muzzle positions once for better "incoming" directions
     TArray<FVector> Muzzles;
-    for (int32 i = 0; i < Attacker->ModelMeshes.Num(); ++i)
-        if (UStaticMeshComponent* C = Attacker->ModelMeshes[i])
-            Muzzles.Add(Attacker->GetMuzzleTransform(i).GetLocation());
+    for (int32 i = 0; i < Attacker->GetNumModelVisuals(); ++i)
+        Muzzles.Add(Attacker->GetMuzzleTransform(i).GetLocation());
 
     auto NearestMuzzleTo = [&Muzzles](const FVector& P)->FVector
     {
@@ -125,16 +107,9 @@ static void BuildImpactSites_Server(const AUnitBase* Attacker, const AUnitBase*
         return (Muzzles.IsValidIndex(BestIdx) ? Muzzles[BestIdx] : P + FVector(100,0,0));
     };
 
-    for (int32 j = 0; j < Target->ModelMeshes.Num(); ++j)
+    for (int32 j = 0; j < Target->GetNumModelVisuals(); ++j)
     {
-        UStaticMeshComponent* TC = Target->ModelMeshes[j];
-        if (!IsValid(TC)) continue;
-
-        FVector ImpactLoc;
-        if (TC->DoesSocketExist(Target->ImpactSocketName))
-            ImpactLoc = TC->GetSocketTransform(Target->ImpactSocketName, ERelativeTransformSpace::RTS_World).GetLocation();
-        else
-            ImpactLoc = TC->GetComponentTransform().TransformPosition(Target->ImpactOffsetLocal);
+        const FVector ImpactLoc = Target->GetModelImpactPoint(j);
 
         const FVector From = NearestMuzzleTo(ImpactLoc);
         FImpactSite S;
@@ -206,16 +181,14 @@ UAbilityEventSubsystem* AMatchGameMode::AbilityBus(UWorld* W)
     return nullptr;
 }
 
-int32 AMatchGameMode::ApplyFeelNoPain(int32 IncomingDamage, int32 Fnp)
+int32 AMatchGameMode::ApplyFeelNoPain(int32 IncomingDamage, int32 Fnp, FCombatDice& Dice)
 {
     if (IncomingDamage <= 0) return 0;
     if (Fnp < 2 || Fnp > 6) return IncomingDamage; // 7 = none
 
-    int32 prevented = 0;
-    for (int32 i = 0; i < IncomingDamage; ++i)
-    {
-        if (D6() >= Fnp) ++prevented;
-    }
+    TArray<uint8, TInlineAllocator<64>> Rolls;
+    Dice.RollD6Batch(IncomingDamage, Rolls);
+    const int32 prevented = DiceKernel::CountAtLeast(Rolls.GetData(), Rolls.Num(), Fnp);
     return FMath::Max(0, IncomingDamage - prevented);
 }
 
@@ -244,29 +217,33 @@ void AMatchGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutL
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(AMatchGameState, Phase);
-    DOREPLIFETIME(AMatchGameState, CurrentDeployer);
-    DOREPLIFETIME(AMatchGameState, P1Remaining);
-    DOREPLIFETIME(AMatchGameState, P2Remaining);
-    DOREPLIFETIME(AMatchGameState, bDeploymentComplete);
-    DOREPLIFETIME(AMatchGameState, P1);
-    DOREPLIFETIME(AMatchGameState, P2);
-    DOREPLIFETIME(AMatchGameState, bTeamsAndTurnsInitialized);
-    DOREPLIFETIME(AMatchGameState, CurrentRound);
-    DOREPLIFETIME(AMatchGameState, MaxRounds);
-    DOREPLIFETIME(AMatchGameState, TurnInRound);
-    DOREPLIFETIME(AMatchGameState, TurnPhase);
-    DOREPLIFETIME(AMatchGameState, CurrentTurn);
-    DOREPLIFETIME(AMatchGameState, ScoreP1);
-    DOREPLIFETIME(AMatchGameState, ScoreP2);
-    DOREPLIFETIME(AMatchGameState, Preview);
-    DOREPLIFETIME(AMatchGameState, ActionPreview);
-    DOREPLIFETIME(AMatchGameState, FinalSummary);
-    DOREPLIFETIME(AMatchGameState, bShowSummary);
-    DOREPLIFETIME(AMatchGameState, SelectedUnitGlobal);
-    DOREPLIFETIME(AMatchGameState, TargetUnitGlobal);
-	DOREPLIFETIME(AMatchGameState, CoverPresetsTable);
-	DOREPLIFETIME(AMatchGameState, CoverAssignments);
+    // All push-based; writers call the Mark*Dirty group helpers
+    FDoRepLifetimeParams Push;
+    Push.bIsPushBased = true;
+
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, Phase, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, CurrentDeployer, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, P1Remaining, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, P2Remaining, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, bDeploymentComplete, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, P1, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, P2, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, bTeamsAndTurnsInitialized, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, CurrentRound, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, MaxRounds, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, TurnInRound, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, TurnPhase, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, CurrentTurn, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, ScoreP1, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, ScoreP2, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, Preview, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, ActionPreview, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, FinalSummary, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, bShowSummary, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, SelectedUnitGlobal, Push);
+    DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, TargetUnitGlobal, Push);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, CoverPresetsTable, Push);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AMatchGameState, CoverAssignments, Push);
 }
 
 void AMatchGameState::Multicast_ScreenMsg_Implementation(const FString& Text, FColor Color, float Time, int32 Key)
@@ -275,25 +252,7 @@ void AMatchGameState::Multicast_ScreenMsg_Implementation(const FString& Text, FC
     if (GEngine) GEngine->AddOnScreenDebugMessage(Key, Time, Color, Text);
 }
 
-void AMatchGameState::Multicast_DrawWorldText_Implementation(const FVector& WorldLoc, const FString& Text, FColor Color, float Time, float /*FontScale*/)
-{
-    if (!bEnableNetDebugDraw) return;
-    UWorld* W = GetWorld(); if (!W) return;
-
-    FTransform T(FRotator::ZeroRotator, WorldLoc);
-    TSubclassOf<ANetDebugTextActor> Cls = DebugTextActorClass;
-    if (!Cls)
-    {
-        Cls = TSubclassOf<ANetDebugTextActor>(ANetDebugTextActor::StaticClass());
-    }
-
-    if (ANetDebugTextActor* A = W->SpawnActorDeferred<ANetDebugTextActor>(Cls, T))
-    {
-        A->Init(Text, Color, DebugTextWorldSize, Time);
-        UGameplayStatics::FinishSpawningActor(A, T);
-    }
-}
-
+#if TABLETOP_NET_DEBUG
 static void DrawLineViaBatcher(UWorld* World, const FVector& A, const FVector& B, const FLinearColor& Color, float Thickness, float Time)
 {
     if (!World) return;
@@ -306,34 +265,105 @@ static void DrawLineViaBatcher(UWorld* World, const FVector& A, const FVector& B
     // Fallback (may be compiled out in Shipping)
     DrawDebugLine(World, A, B, Color.ToFColor(true), false, Time, 0, Thickness);
 }
+#endif
+
+// ---- debug draw batches ----
 
-void AMatchGameState::Multicast_DrawLine_Implementation(const FVector& Start, const FVector& End, FColor Color, float Time, float Thickness)
+void AMatchGameState::QueueDebugPrim(FTabletopDebugPrim&& Prim)
 {
-    if (!bDrawDebugHelpers) return;
-    DrawLineViaBatcher(GetWorld(), Start, End, Color, Thickness, Time);
+    PendingDebugPrims.Add(MoveTemp(Prim));
+    if (!bDebugFlushQueued)
+    {
+        bDebugFlushQueued = true;
+        GetWorldTimerManager().SetTimerForNextTick(this, &AMatchGameState::FlushDebugPrims);
+    }
 }
 
-void AMatchGameState::Multicast_DrawSphere_Implementation(const FVector& Center, float Radius, int32 Segments, FColor Color, float Time, float Thickness)
+void AMatchGameState::FlushDebugPrims()
 {
-    if (!bDrawDebugHelpers) return;
-    UWorld* World = GetWorld();
-    if (!World) return;
+    bDebugFlushQueued = false;
+    if (PendingDebugPrims.Num() == 0) return;
 
-    const int32 N = FMath::Max(8, Segments);
-    auto Ring = [&](const FVector& X, const FVector& Y)
+    // One RPC per frame; only a pathological frame (exhaustive cover cross on big squads) gets split,
+    // to keep each unreliable bunch well under a packet or two
+    constexpr int32 MaxPrimsPerRPC = 64;
+    if (PendingDebugPrims.Num() <= MaxPrimsPerRPC)
+    {
+        Multicast_DebugDrawBatch(PendingDebugPrims);
+        INC_DWORD_STAT(STAT_TabletopDebugDrawRPCs);
+    }
+    else
     {
-        FVector Prev = Center + X * Radius;
-        for (int32 i=1;i<=N;++i)
+        for (int32 i = 0; i < PendingDebugPrims.Num(); i += MaxPrimsPerRPC)
         {
-            const float T = (float)i / (float)N * 2.f * PI;
-            const FVector P = Center + (X*FMath::Cos(T) + Y*FMath::Sin(T)) * Radius;
-            DrawLineViaBatcher(World, Prev, P, Color, Thickness, Time);
-            Prev = P;
+            const int32 N = FMath::Min(MaxPrimsPerRPC, PendingDebugPrims.Num() - i);
+            Multicast_DebugDrawBatch(TArray<FTabletopDebugPrim>(PendingDebugPrims.GetData() + i, N));
+            INC_DWORD_STAT(STAT_TabletopDebugDrawRPCs);
         }
-    };
-    Ring(FVector::RightVector, FVector::ForwardVector); // XY
-    Ring(FVector::RightVector, FVector::UpVector);      // XZ
-    Ring(FVector::UpVector,    FVector::ForwardVector); // YZ
+    }
+    INC_DWORD_STAT_BY(STAT_TabletopDebugDrawPrims, PendingDebugPrims.Num());
+    PendingDebugPrims.Reset();
+}
+
+void AMatchGameState::Multicast_DebugDrawBatch_Implementation(const TArray<FTabletopDebugPrim>& Prims)
+{
+#if TABLETOP_NET_DEBUG
+    if (!bEnableNetDebugDraw || GetNetMode() == NM_DedicatedServer) return;
+    UWorld* W = GetWorld(); if (!W) return;
+
+    TSubclassOf<ANetDebugTextActor> TextCls = DebugTextActorClass;
+    if (!TextCls)
+    {
+        TextCls = TSubclassOf<ANetDebugTextActor>(ANetDebugTextActor::StaticClass());
+    }
+
+    for (const FTabletopDebugPrim& P : Prims)
+    {
+        const float Time = P.Duration * 0.1f;
+        switch ((ETabletopDebugPrimKind)P.Kind)
+        {
+        case ETabletopDebugPrimKind::Line:
+            DrawLineViaBatcher(W, P.A, P.B, P.Color, P.Thickness * 0.25f, Time);
+            break;
+
+        case ETabletopDebugPrimKind::Sphere:
+        {
+            const int32 N = 12;
+            const float Radius = P.Radius;
+            auto Ring = [&](const FVector& X, const FVector& Y)
+            {
+                FVector Prev = P.A + X * Radius;
+                for (int32 i=1;i<=N;++i)
+                {
+                    const float T = (float)i / (float)N * 2.f * PI;
+                    const FVector Pt = P.A + (X*FMath::Cos(T) + Y*FMath::Sin(T)) * Radius;
+                    DrawLineViaBatcher(W, Prev, Pt, P.Color, P.Thickness * 0.25f, Time);
+                    Prev = Pt;
+                }
+            };
+            Ring(FVector::RightVector, FVector::ForwardVector); // XY
+            Ring(FVector::RightVector, FVector::UpVector);      // XZ
+            Ring(FVector::UpVector,    FVector::ForwardVector); // YZ
+            break;
+        }
+
+        case ETabletopDebugPrimKind::Text:
+        {
+            const FTransform T(FRotator::ZeroRotator, P.A);
+            if (ANetDebugTextActor* A = W->SpawnActorDeferred<ANetDebugTextActor>(TextCls, T))
+            {
+                A->Init(P.Text, P.Color, DebugTextWorldSize * (P.Thickness * 0.1f), Time);
+                UGameplayStatics::FinishSpawningActor(A, T);
+            }
+            break;
+        }
+
+        case ETabletopDebugPrimKind::Screen:
+            if (GEngine) GEngine->AddOnScreenDebugMessage(-1, Time, P.Color, P.Text);
+            break;
+        }
+    }
+#endif
 }
 
 void AMatchGameState::OnRep_Preview()
@@ -409,13 +439,68 @@ void AMatchGameState::Multicast_ClearPotentialTargets_Implementation()
 void AMatchGameState::BeginPlay()
 {
     Super::BeginPlay();
+    // Catch markers that began play before we did (client GS arriving late); later ones register themselves
     TArray<AActor*> Found;
     UGameplayStatics::GetAllActorsOfClass(GetWorld(), AObjectiveMarker::StaticClass(), Found);
     Objectives.Reserve(Found.Num());
     for (AActor* A : Found)
-        if (auto* M = Cast<AObjectiveMarker>(A)) Objectives.Add(M);
+        if (auto* M = Cast<AObjectiveMarker>(A)) RegisterObjective(M);
 
 	FWorldDelegates::LevelAddedToWorld.AddUObject(this, &AMatchGameState::OnLevelAdded);
+	TabletopPushModel::TrackActor(this, /*bAdd*/true);
+}
+
+void AMatchGameState::EndPlay(const EEndPlayReason::Type Reason)
+{
+	TabletopPushModel::TrackActor(this, /*bAdd*/false);
+	Super::EndPlay(Reason);
+}
+
+// ---- push-model dirties (server) ----
+
+void AMatchGameState::MarkMatchDirty()
+{
+	TABLETOP_MARK_DIRTY(AMatchGameState, CurrentRound, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, MaxRounds, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, TurnInRound, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, TurnPhase, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, CurrentTurn, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, ScoreP1, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, ScoreP2, this);
+}
+
+void AMatchGameState::MarkDeploymentDirty()
+{
+	TABLETOP_MARK_DIRTY(AMatchGameState, Phase, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, CurrentDeployer, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, P1Remaining, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, P2Remaining, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, bDeploymentComplete, this);
+}
+
+void AMatchGameState::MarkPlayersDirty()
+{
+	TABLETOP_MARK_DIRTY(AMatchGameState, P1, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, P2, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, bTeamsAndTurnsInitialized, this);
+}
+
+void AMatchGameState::MarkPreviewDirty()
+{
+	TABLETOP_MARK_DIRTY(AMatchGameState, Preview, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, ActionPreview, this);
+}
+
+void AMatchGameState::MarkSummaryDirty()
+{
+	TABLETOP_MARK_DIRTY(AMatchGameState, FinalSummary, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, bShowSummary, this);
+}
+
+void AMatchGameState::MarkCoverDirty()
+{
+	TABLETOP_MARK_DIRTY(AMatchGameState, CoverPresetsTable, this);
+	TABLETOP_MARK_DIRTY(AMatchGameState, CoverAssignments, this);
 }
 
 void AMatchGameMode::Emit(ECombatEvent E, AUnitBase* Src, AUnitBase* Tgt,
@@ -597,6 +682,7 @@ void AMatchGameState::SetGlobalSelected(AUnitBase* NewSel)
 
     if (SelectedUnitGlobal == NewSel) return;
     SelectedUnitGlobal = NewSel;
+    TABLETOP_MARK_DIRTY(AMatchGameState, SelectedUnitGlobal, this);
 
     Multicast_ApplySelectionVis(SelectedUnitGlobal, TargetUnitGlobal);
     ForceNetUpdate();
@@ -629,6 +715,7 @@ void AMatchGameState::SetGlobalTarget(AUnitBase* NewTgt)
 
     if (TargetUnitGlobal == NewTgt) return;
     TargetUnitGlobal = NewTgt;
+    TABLETOP_MARK_DIRTY(AMatchGameState, TargetUnitGlobal, this);
 
     Multicast_ApplySelectionVis(SelectedUnitGlobal, TargetUnitGlobal);
     ForceNetUpdate();
@@ -655,9 +742,9 @@ void AMatchGameMode::RebroadcastCoverPresetsReliable()
 	if (!HasAuthority()) return;
 	UWorld* W = GetWorld(); AMatchGameState* S = GS(); if (!W || !S) return;
 
-	for (TActorIterator<ACoverVolume> It(W); It; ++It)
+	TArray<ACoverVolume*> Covers; CollectCoverVolumes_AllLevels(W, Covers);
+	for (ACoverVolume* CV : Covers)
 	{
-		ACoverVolume* CV = *It;
 		if (!CV) continue;
 
 		// Skip rebroadcasting "empty" state; it causes clients to apply nulls
@@ -757,55 +844,48 @@ TArray<FVector> AMatchGameMode::ComputeCohesiveCoveredFormation(
 		for (auto& p: pts) if (p.Size() <= MaxRadius) Candidates.Add(UnitCenter + FVector(p.X, p.Y, 0));
 	}
 
-	TArray<ACoverVolume*> AllCovers;
-	for (TActorIterator<ACoverVolume> It(GetWorld()); It; ++It) if (*It) AllCovers.Add(*It);
+	// Treat "base radius" as the minimum desired clearance from cover collision
+	const float DesiredClearance = FMath::Clamp(BaseRadiusCm * 0.95f, 10.f, 120.f);
+
+	const UTabletopCoverRegistrySubsystem* CoverRegistry = UTabletopCoverRegistrySubsystem::Get(this);
 	
 	// Returns distance from P to nearest cover surface; OutNormal points *away from cover*.
 	// If the point is inside (distance ~ 0), we synthesize a reasonable outward direction.
+	// Callers only act on clear < DesiredClearance, so the registry only looks that far (bounds first, physics on survivors).
 	auto NearestCoverClearance = [&](const FVector& P, FVector& OutNormal)->float
 	{
-		float best = TNumericLimits<float>::Max();
 		OutNormal = FVector::ZeroVector;
+		if (!CoverRegistry) return TNumericLimits<float>::Max();
 
-		for (ACoverVolume* CV : AllCovers)
-		{
-			if (!CV || !CV->Box) continue;
-
-			FVector OnSurface;
-			const float d = CV->Box->GetClosestPointOnCollision(P, OnSurface, NAME_None);
-			if (d < 0.f) continue; // no valid body instance
-
-			if (d < best)
-			{
-				best = d;
+		ACoverVolume* CV = nullptr;
+		FVector OnSurface;
+		const float d = CoverRegistry->FindNearestCover(P, DesiredClearance, CV, OnSurface);
+		if (d < 0.f || !CV) return TNumericLimits<float>::Max(); // FLT_MAX means "no cover found"
 
-				// Prefer pushing away from the surface point we got back
-				FVector dir = (P - OnSurface);
-				if (!dir.IsNearlyZero())
-				{
-					OutNormal = dir.GetSafeNormal2D();
-				}
-				else
-				{
-					// Fallback (e.g., exactly on the surface or degenerate): push away from actor center
-					OutNormal = (P - CV->GetActorLocation()).GetSafeNormal2D();
-				}
-			}
+		// Prefer pushing away from the surface point we got back
+		FVector dir = (P - OnSurface);
+		if (!dir.IsNearlyZero())
+		{
+			OutNormal = dir.GetSafeNormal2D();
+		}
+		else
+		{
+			// Fallback (e.g., exactly on the surface or degenerate): push away from actor center
+			OutNormal = (P - CV->GetActorLocation()).GetSafeNormal2D();
 		}
-		return best; // FLT_MAX means "no cover found"
+		return d;
 	};
 
-	// Treat "base radius" as the minimum desired clearance from cover collision
-	const float DesiredClearance = FMath::Clamp(BaseRadiusCm * 0.95f, 10.f, 120.f);
-
 	// Quick cover test near a point (like above)
 	auto CoveredAt = [&](const FVector& P)->ECoverType
 	{
+		// Only a hit within 6" counts; the baked grid can rule that out without a trace
+		if (CoverRegistry && CoverRegistry->IsCoverProvablyBeyond(P, 6.f * CmPerTabletopInch())) return ECoverType::None;
+
 		const FVector From = P + (-ThreatDir).GetSafeNormal() * (MaxRadius*1.2f) + FVector(0,0,60);
 		FHitResult Hit;
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(FormCover), false);
 		// ignore units in formation solve
-		for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It) Params.AddIgnoredActor(*It);
+		const FCollisionQueryParams& Params = GetUnitIgnoreParams(EUnitIgnoreTrace::Formation);
 		if (!GetWorld()->LineTraceSingleByChannel(Hit, From, P, CoverTraceChannel, Params)) return ECoverType::None;
 		if (ACoverVolume* CV = Cast<ACoverVolume>(Hit.GetActor()))
 		{
@@ -914,36 +994,100 @@ TArray<FVector> AMatchGameMode::ComputeCohesiveCoveredFormation(
 	return Out;
 }
 
-bool AMatchGameMode::QueryCoverWithActor(
-    AUnitBase* Attacker, AUnitBase* Target,
-    int32& OutHitMod, int32& OutSaveMod, ECoverType& OutType,
-    ACoverVolume*& OutPrimaryCover, TMap<ACoverVolume*, int32>* OutCoverHits) const
+const FCollisionQueryParams& AMatchGameMode::MakeCoverTraceParams() const
 {
-    OutHitMod=0; OutSaveMod=0; OutType=ECoverType::None; OutPrimaryCover=nullptr;
+    // Ignore all units; allow hitting cover or world
+    return GetUnitIgnoreParams(EUnitIgnoreTrace::Cover);
+}
 
-    UWorld* W = GetWorld(); if (!W || !Attacker || !Target) return false;
-    AMatchGameState* S = GS(); const bool bDraw = (S && bDebugCoverTraces);
+const FCollisionQueryParams& AMatchGameMode::GetUnitIgnoreParams(EUnitIgnoreTrace Kind) const
+{
+    if (bUnitIgnoreParamsDirty)
+    {
+        RebuildUnitIgnoreParams();
+    }
+    return UnitIgnoreParams[(int32)Kind];
+}
+
+void AMatchGameMode::RebuildUnitIgnoreParams() const
+{
+    // Unit components already only answer the selection channel, so cover/LOS traces pass through them
+    // by response alone. The ignore list stays as a guard for anything a unit BP bolts on.
+    UnitIgnoreParams[(int32)EUnitIgnoreTrace::Cover]     = FCollisionQueryParams(SCENE_QUERY_STAT(CoverTraceFull), false);
+    UnitIgnoreParams[(int32)EUnitIgnoreTrace::LOS]       = FCollisionQueryParams(SCENE_QUERY_STAT(UnitLOS), /*bTraceComplex*/ true);
+    UnitIgnoreParams[(int32)EUnitIgnoreTrace::Formation] = FCollisionQueryParams(SCENE_QUERY_STAT(FormCover), false);
+
+    if (UWorld* World = GetWorld())
+    {
+        TArray<const AActor*> Units;
+        Units.Reserve(64);
+        for (TActorIterator<AUnitBase> It(World); It; ++It)
+        {
+            if (IsValid(*It)) Units.Add(*It);
+        }
+        for (FCollisionQueryParams& P : UnitIgnoreParams)
+        {
+            P.AddIgnoredActors(Units);
+        }
+    }
+    bUnitIgnoreParamsDirty = false;
+}
+
+template<typename FuncType>
+void AMatchGameMode::ForEachTeamUnit(const APlayerState* Team, FuncType&& Func) const
+{
+    // Walk a copy: callbacks emit combat events, and abilities reacting to them may spawn or kill units
+    auto Walk = [&Func](const FTeamUnitList& List)
+    {
+        const FTeamUnitList Snapshot = List;
+        for (const TWeakObjectPtr<AUnitBase>& W : Snapshot)
+        {
+            if (AUnitBase* U = W.Get()) Func(U);
+        }
+    };
+
+    if (Team)
+    {
+        if (const FTeamUnitList* List = TeamUnits.Find(Team)) Walk(*List);
+        return;
+    }
+    FTeamUnitList All;
+    for (const TPair<TObjectKey<APlayerState>, FTeamUnitList>& It : TeamUnits) All.Append(It.Value);
+    Walk(All);
+}
+
+void AMatchGameMode::HandleActorSpawned(AActor* Actor)
+{
+    if (Actor && Actor->IsA<AUnitBase>()) bUnitIgnoreParamsDirty = true;
+}
+
+void AMatchGameMode::HandleActorDestroyed(AActor* Actor)
+{
+    if (AUnitBase* U = Cast<AUnitBase>(Actor))
+    {
+        UnregisterTeamUnit(U);
+        bUnitIgnoreParamsDirty = true;
+        bCoverMemoryNeedsPrune = true;
+    }
+    else if (Actor && Actor->IsA<ACoverVolume>())
+    {
+        BumpCoverWorldVersion();
+    }
+}
+
+int32 AMatchGameMode::BuildCoverRays(const AUnitBase* Attacker, const AUnitBase* Target, TArray<FCoverRay>& OutRays) const
+{
+    OutRays.Reset();
 
     // Collect attacker/target points
     TArray<FVector> APoints;
-    for (int i=0;i<Attacker->ModelMeshes.Num();++i) APoints.Add(Attacker->GetMuzzleTransform(i).GetLocation());
+    for (int i=0;i<Attacker->GetNumModelVisuals();++i) APoints.Add(Attacker->GetMuzzleTransform(i).GetLocation());
     if (APoints.Num()==0) APoints.Add(Attacker->GetActorLocation());
 
     TArray<FVector> TPoints;
 	GetTargetModelHitPoints(Target,TPoints);
     if (TPoints.Num()==0) TPoints.Add(Target->GetActorLocation());
 
-    // Ignore all units; allow hitting cover or world
-    FCollisionQueryParams Params(SCENE_QUERY_STAT(CoverTraceFull), false);
-    for (TActorIterator<AUnitBase> It(W); It; ++It) Params.AddIgnoredActor(*It);
-
-    auto DrawRay = [&](const FVector& A, const FVector& B, const FColor& C, float Thk=2.f){
-        if (bDraw) S->Multicast_DrawLine(A,B,C,4.f,Thk);
-    };
-    auto Note = [&](const FVector& P, const FString& Msg, const FColor& C){
-        if (bDraw){ S->Multicast_DrawSphere(P,10.f,10,C,4.f,1.5f); S->Multicast_DrawWorldText(P+FVector(0,0,16),Msg,C,4.f,0.9f); }
-    };
-
     // Optional nearest-N selection (fast) or exhaustive cross-matrix
     auto NearestIdxs = [&](const FVector& P, int32 N)->TArray<int32>{
         TArray<int32> Idx; for (int32 i=0;i<APoints.Num();++i) Idx.Add(i);
@@ -953,26 +1097,56 @@ bool AMatchGameMode::QueryCoverWithActor(
     };
 
     const int32 RaysN = bExhaustiveCoverCross ? APoints.Num() : FMath::Clamp(RaysPerTargetModel,1,4);
+    OutRays.Reserve(TPoints.Num() * RaysN);
+
+    for (int32 m = 0; m < TPoints.Num(); ++m)
+    {
+        const FVector& TP = TPoints[m];
+        if (bExhaustiveCoverCross)
+        {
+            for (const FVector& From : APoints) OutRays.Add({ From, TP, m });
+        }
+        else
+        {
+            for (int32 i : NearestIdxs(TP, RaysN)) OutRays.Add({ APoints[i], TP, m });
+        }
+    }
+    return TPoints.Num();
+}
+
+bool AMatchGameMode::EvaluateCoverRays(AUnitBase* Attacker, AUnitBase* Target,
+                                       const TArray<FCoverRay>& Rays, const TArray<FHitResult>& Hits,
+                                       int32 NumModels, const FCoverCacheStamp& Stamp, FCoverQueryResult& Out) const
+{
+    Out = FCoverQueryResult();
+
+    UWorld* W = GetWorld(); if (!W || !Attacker || !Target) return false;
+    AMatchGameState* S = GS(); const bool bDraw = FTabletopDebugDraw::IsEnabled(ETabletopDebugCategory::Cover, bDebugCoverTraces);
+
+    auto DrawRay = [&](const FVector& A, const FVector& B, const FColor& C, float Thk=2.f){
+        if (bDraw) FTabletopDebugDraw::Line(W,A,B,C,4.f,Thk);
+    };
+    auto Note = [&](const FVector& P, const FString& Msg, const FColor& C){
+        if (bDraw){ FTabletopDebugDraw::Sphere(W,P,10.f,C,4.f,1.5f); FTabletopDebugDraw::Text(W,P+FVector(0,0,16),Msg,C,4.f,0.9f); }
+    };
 
     int32 CoveredModels = 0; bool AnyHigh=false;
     TMap<ACoverVolume*, int32> HitsPerCoverLocal;
 
-    int32 ModelIdx = 0;
-    for (const FVector& TP : TPoints)
+    // Rays are grouped per target model, in model order
+    int32 r = 0;
+    for (int32 m = 0; m < NumModels; ++m)
     {
-        ++ModelIdx;
-        TArray<int32> Idx = bExhaustiveCoverCross ? TArray<int32>() : NearestIdxs(TP, RaysN);
-        if (bExhaustiveCoverCross){ Idx.Reserve(APoints.Num()); for (int32 i=0;i<APoints.Num();++i) Idx.Add(i); }
-
+        const int32 ModelIdx = m + 1;
         bool bModelCovered=false; ECoverType ModelCT=ECoverType::None;
 
-        for (int32 i : Idx)
+        for (; r < Rays.Num() && Rays[r].ModelIdx == m; ++r)
         {
-            const FVector From = APoints[i];
-            FHitResult HR;
-            const bool bHit = W->LineTraceSingleByChannel(HR, From, TP, CoverTraceChannel, Params);
+            const FVector& From = Rays[r].From;
+            const FVector& TP   = Rays[r].To;
+            const FHitResult& HR = Hits[r];
 
-            if (!bHit)
+            if (!HR.bBlockingHit)
             {
                 DrawRay(From, TP, FColor::Red, 1.5f);
                 continue;
@@ -1005,17 +1179,16 @@ bool AMatchGameMode::QueryCoverWithActor(
             ++CoveredModels;
             if (ModelCT == ECoverType::High) AnyHigh=true;
         }
-        else
+        else if (Rays.IsValidIndex(r - 1))
         {
-            Note(TP, FString::Printf(TEXT("Model %d: no cover"), ModelIdx), FColor::Red);
+            Note(Rays[r - 1].To, FString::Printf(TEXT("Model %d: no cover"), ModelIdx), FColor::Red);
         }
     }
 
-    const int32 Total = FMath::Max(1, TPoints.Num());
+    const int32 Total = FMath::Max(1, NumModels);
     const float Frac  = float(CoveredModels) / float(Total);
 
     // Hysteresis as before
-    const float Now=W->TimeSeconds;
     FCoverPairKey Key{Attacker, Target};
     FCoverPairCache Old{}; if (const FCoverPairCache* F = CoverMemory.Find(Key)) Old=*F;
     const float OnT = CoverModelCoverageThreshold;
@@ -1029,13 +1202,13 @@ bool AMatchGameMode::QueryCoverWithActor(
     for (auto& KV : HitsPerCoverLocal)
         if (KV.Value > BestHits) { BestHits=KV.Value; Primary=KV.Key; }
 
-    OutType = SquadCT;
-    OutHitMod  = (SquadCT==ECoverType::High)? -1 : 0;
-    OutSaveMod = (SquadCT!=ECoverType::None)?  1 : 0;
-    OutPrimaryCover = Primary;
-    if (OutCoverHits) *OutCoverHits = HitsPerCoverLocal;
+    Out.Type    = SquadCT;
+    Out.HitMod  = (SquadCT==ECoverType::High)? -1 : 0;
+    Out.SaveMod = (SquadCT!=ECoverType::None)?  1 : 0;
+    Out.Primary = Primary;
+    Out.CoverHits = MoveTemp(HitsPerCoverLocal);
 
-    if (S->bDrawDebugHelpers)
+    if (S && S->bDrawDebugHelpers)
     {
         const FVector Mid=(Attacker->GetActorLocation()+Target->GetActorLocation())*0.5f+FVector(0,0,140.f);
         FString pick = Primary? Primary->GetName() : TEXT("none");
@@ -1047,13 +1220,185 @@ bool AMatchGameMode::QueryCoverWithActor(
             SquadCT==ECoverType::None?FColor::Red:FColor::Green, 5.f);
     }
 
-    // Save memory for hysteresis
-    FCoverPairCache NewMem; NewMem.LastFraction=Frac; NewMem.LastType=SquadCT;
-    const_cast<AMatchGameMode*>(this)->CoverMemory.Add(Key, NewMem);
+    // Save memory for hysteresis, plus the whole result so the next ask with the same versions skips the traces
+    FCoverPairCache& NewMem = CoverMemory.FindOrAdd(Key);
+    NewMem.LastFraction = Frac;
+    NewMem.LastType     = SquadCT;
+    NewMem.Stamp        = Stamp;
+    NewMem.Result       = Out;
+    NewMem.TraceCount   = Rays.Num();
+    NewMem.bHasResult   = true;
+    SET_DWORD_STAT(STAT_CoverCacheEntries, CoverMemory.Num());
 
     return SquadCT != ECoverType::None;
 }
 
+bool AMatchGameMode::QueryCoverWithActor(
+    AUnitBase* Attacker, AUnitBase* Target,
+    int32& OutHitMod, int32& OutSaveMod, ECoverType& OutType,
+    ACoverVolume*& OutPrimaryCover, TMap<ACoverVolume*, int32>* OutCoverHits) const
+{
+    OutHitMod=0; OutSaveMod=0; OutType=ECoverType::None; OutPrimaryCover=nullptr;
+
+    UWorld* W = GetWorld(); if (!W || !Attacker || !Target) return false;
+
+    FCoverQueryResult R;
+    bool bCover = false;
+    if (FindCachedCover(Attacker, Target, R))
+    {
+        bCover = (R.Type != ECoverType::None);
+    }
+    else
+    {
+        TArray<FCoverRay> Rays;
+        const FCoverCacheStamp Stamp = MakeCoverStamp(Attacker, Target);
+        const int32 NumModels = BuildCoverRays(Attacker, Target, Rays);
+
+        const FCollisionQueryParams& Params = MakeCoverTraceParams();
+        TArray<FHitResult> Hits;
+        Hits.SetNum(Rays.Num());
+        if (!AreCoverRaysProvablyClear(Rays))
+        {
+            for (int32 i = 0; i < Rays.Num(); ++i)
+            {
+                W->LineTraceSingleByChannel(Hits[i], Rays[i].From, Rays[i].To, CoverTraceChannel, Params);
+            }
+        }
+
+        bCover = EvaluateCoverRays(Attacker, Target, Rays, Hits, NumModels, Stamp, R);
+    }
+
+    OutHitMod       = R.HitMod;
+    OutSaveMod      = R.SaveMod;
+    OutType         = R.Type;
+    OutPrimaryCover = R.Primary;
+    if (OutCoverHits) *OutCoverHits = MoveTemp(R.CoverHits);
+    return bCover;
+}
+
+bool AMatchGameMode::AreCoverRaysProvablyClear(const TArray<FCoverRay>& Rays) const
+{
+    const UTabletopCoverRegistrySubsystem* Registry = UTabletopCoverRegistrySubsystem::Get(this);
+    if (!Registry || !Registry->GetTrustedBake() || Rays.Num() == 0) return false;
+
+    for (const FCoverRay& R : Rays)
+    {
+        if (!Registry->IsSegmentProvablyClear(R.From, R.To)) return false;
+    }
+    return true;
+}
+
+FCoverCacheStamp AMatchGameMode::MakeCoverStamp(const AUnitBase* Attacker, const AUnitBase* Target) const
+{
+    FCoverCacheStamp Stamp;
+    Stamp.AttackerVersion = Attacker ? Attacker->GetTransformVersion() : 0;
+    Stamp.TargetVersion   = Target   ? Target->GetTransformVersion()   : 0;
+    Stamp.CoverVersion    = CoverWorldVersion;
+    return Stamp;
+}
+
+bool AMatchGameMode::FindCachedCover(const AUnitBase* Attacker, const AUnitBase* Target, FCoverQueryResult& Out) const
+{
+    if (bCoverMemoryNeedsPrune) PruneCoverMemory();
+
+    const FCoverPairCache* Entry = CoverMemory.Find(FCoverPairKey{Attacker, Target});
+    if (Entry && Entry->bHasResult && Entry->Stamp == MakeCoverStamp(Attacker, Target))
+    {
+        Out = Entry->Result;
+        ++CoverCacheHits;
+        CoverTracesSaved += Entry->TraceCount;
+        INC_DWORD_STAT(STAT_CoverCacheHits);
+        INC_DWORD_STAT_BY(STAT_CoverTracesSaved, Entry->TraceCount);
+        return true;
+    }
+
+    ++CoverCacheMisses;
+    INC_DWORD_STAT(STAT_CoverCacheMisses);
+    return false;
+}
+
+void AMatchGameMode::PruneCoverMemory() const
+{
+    // Drop pairs whose attacker or target no longer exists
+    for (auto It = CoverMemory.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().A.IsValid() || !It.Key().T.IsValid()) It.RemoveCurrent();
+    }
+    bCoverMemoryNeedsPrune = false;
+    SET_DWORD_STAT(STAT_CoverCacheEntries, CoverMemory.Num());
+}
+
+void AMatchGameMode::CoverCache_Dump()
+{
+    const uint64 Total = CoverCacheHits + CoverCacheMisses;
+    UE_LOG(LogCoverNet, Display, TEXT("[GM] Cover cache: %d pairs  hits=%llu misses=%llu (%.1f%%)  traces saved=%llu  coverVer=%u"),
+        CoverMemory.Num(), CoverCacheHits, CoverCacheMisses,
+        Total > 0 ? 100.0 * double(CoverCacheHits) / double(Total) : 0.0,
+        CoverTracesSaved, CoverWorldVersion);
+}
+
+void AMatchGameMode::QueryCoverAsync(AUnitBase* Attacker, AUnitBase* Target, TFunction<void(const FCoverQueryResult&)>&& OnDone)
+{
+    UWorld* W = GetWorld();
+    if (!W || !Attacker || !Target) { OnDone(FCoverQueryResult()); return; }
+
+    const uint32 QueryId = NextCoverQueryId++;
+    FPendingCoverQuery& Q = PendingCoverQueries.Add(QueryId);
+    Q.Attacker  = Attacker;
+    Q.Target    = Target;
+    Q.Stamp     = MakeCoverStamp(Attacker, Target);
+    Q.NumModels = BuildCoverRays(Attacker, Target, Q.Rays);
+    Q.Hits.SetNum(Q.Rays.Num());
+    Q.Outstanding = AreCoverRaysProvablyClear(Q.Rays) ? 0 : Q.Rays.Num();
+    Q.OnDone    = MoveTemp(OnDone);
+
+    if (Q.Outstanding == 0)
+    {
+        // Nothing to trace (no model meshes yet, or the baked grid proves every ray clear); evaluate straight away
+        FPendingCoverQuery Done;
+        PendingCoverQueries.RemoveAndCopyValue(QueryId, Done);
+        FCoverQueryResult R;
+        EvaluateCoverRays(Attacker, Target, Done.Rays, Done.Hits, Done.NumModels, Done.Stamp, R);
+        Done.OnDone(R);
+        return;
+    }
+
+    // Whole cross-matrix goes out as one batch; results come back through the delegate next frame
+    const FCollisionQueryParams& Params = MakeCoverTraceParams();
+    const FTraceDelegate Delegate = FTraceDelegate::CreateUObject(this, &AMatchGameMode::OnCoverTraceDone, QueryId);
+    for (int32 i = 0; i < Q.Rays.Num(); ++i)
+    {
+        W->AsyncLineTraceByChannel(EAsyncTraceType::Single, Q.Rays[i].From, Q.Rays[i].To, CoverTraceChannel,
+                                   Params, FCollisionResponseParams::DefaultResponseParam, &Delegate, (uint32)i);
+    }
+}
+
+void AMatchGameMode::DropPendingCoverQueries()
+{
+	// Traces already in flight still call OnCoverTraceDone, which just won't find their query any more
+	PendingCoverQueries.Reset();
+	PendingShotAttackers.Reset();
+}
+
+void AMatchGameMode::OnCoverTraceDone(const FTraceHandle& /*Handle*/, FTraceDatum& Datum, uint32 QueryId)
+{
+    FPendingCoverQuery* Q = PendingCoverQueries.Find(QueryId);
+    if (!Q) return;
+
+    if (Q->Hits.IsValidIndex((int32)Datum.UserData) && Datum.OutHits.Num() > 0)
+    {
+        Q->Hits[Datum.UserData] = Datum.OutHits[0];
+    }
+    if (--Q->Outstanding > 0) return;
+
+    FPendingCoverQuery Done;
+    PendingCoverQueries.RemoveAndCopyValue(QueryId, Done);
+
+    FCoverQueryResult R;
+    EvaluateCoverRays(Done.Attacker.Get(), Done.Target.Get(), Done.Rays, Done.Hits, Done.NumModels, Done.Stamp, R);
+    Done.OnDone(R);
+}
+
 bool AMatchGameMode::QueryCover(AUnitBase* A, AUnitBase* T,
                                 int32& OutHitMod, int32& OutSaveMod, ECoverType& OutType) const
 {
@@ -1085,18 +1430,16 @@ void AMatchGameMode::ApplyDelayedCoverDamage(ACoverVolume* Cover, float Damage,
 
 void AMatchGameMode::ResetTurnFor(APlayerState* PS)
 {
-    for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
+    ForEachTeamUnit(PS, [](AUnitBase* U)
     {
-        if (It->OwningPS == PS)
-        {
-            It->MoveBudgetInches = It->MoveMaxInches;
-            It->bHasShot = false;
-            It->bMovedThisTurn = false;
-            It->bAdvancedThisTurn = false;
-            It->OnTurnAdvanced(); // decay per-turn unit modifiers
-            It->ForceNetUpdate();
-        }
-    }
+        U->MoveBudgetInches = U->MoveMaxInches;
+        U->bHasShot = false;
+        U->bMovedThisTurn = false;
+        U->bAdvancedThisTurn = false;
+        U->MarkTurnStateDirty();
+        U->OnTurnAdvanced(); // decay per-turn unit modifiers
+        U->ForceNetUpdate();
+    });
 }
 
 static inline const TCHAR* CoverTypeToText(ECoverType C)
@@ -1115,20 +1458,18 @@ void AMatchGameMode::BroadcastPotentialTargets(AUnitBase* Attacker)
     // Only show for the active player’s selected attacker
     if (Attacker->OwningPS != S->CurrentTurn) { S->Multicast_ClearPotentialTargets(); return; }
 
+    // Only enemies inside weapon range can pass ValidateShoot, so ask the grid for just those
     TArray<AUnitBase*> Potentials;
-    for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
+    if (const UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(this))
     {
-        AUnitBase* T = *It;
-        if (!T || T == Attacker) continue;
-        if (!Attacker->IsEnemy(T)) continue;
-
-        // Reuse your existing shoot gate (range, alive, not same owner, etc.)
-        if (ValidateShoot(Attacker, T))
-        {
-            Potentials.Add(T);
-        }
+        FUnitSpatialFilter F;
+        F.EnemiesOf = Attacker;
+        Index->QueryRadius(Attacker->GetActorLocation(), Attacker->GetWeaponRange() * CmPerTabletopInch() + 1.f, F, Potentials);
     }
 
+    // Reuse your existing shoot gate (range, alive, not same owner, etc.)
+    Potentials.RemoveAll([this, Attacker](AUnitBase* T) { return !ValidateShoot(Attacker, T); });
+
     S->Multicast_SetPotentialTargets(Potentials);
 }
 
@@ -1163,16 +1504,17 @@ void AMatchGameMode::ResolveMoveToBudget(
         bOutClamped = true;
     }
 
-    if (AMatchGameState* S = GS())
+    const AMatchGameState* S = GS();
+    if (S && FTabletopDebugDraw::IsEnabled(ETabletopDebugCategory::Move, S->bDrawDebugHelpers))
     {
         const FColor Col = bOutClamped ? FColor::Yellow : FColor::Green;
-        S->Multicast_DrawSphere(Start,      25.f, 16, Col,           6.f, 2.f);
-        S->Multicast_DrawSphere(WantedDest, 25.f, 16, FColor::Silver,6.f, 2.f);
-        S->Multicast_DrawSphere(OutFinalDest,25.f,16, Col,           6.f, 2.f);
-        S->Multicast_DrawLine  (Start, OutFinalDest, Col, 6.f, 2.f);
+        FTabletopDebugDraw::Sphere(S, Start,       25.f, Col,            6.f, 2.f);
+        FTabletopDebugDraw::Sphere(S, WantedDest,  25.f, FColor::Silver, 6.f, 2.f);
+        FTabletopDebugDraw::Sphere(S, OutFinalDest,25.f, Col,            6.f, 2.f);
+        FTabletopDebugDraw::Line  (S, Start, OutFinalDest, Col, 6.f, 2.f);
         if (bOutClamped)
         {
-            S->Multicast_DrawLine(OutFinalDest, WantedDest, FColor::Red, 6.f, 1.f);
+            FTabletopDebugDraw::Line(S, OutFinalDest, WantedDest, FColor::Red, 6.f, 1.f);
         }
     }
 }
@@ -1192,18 +1534,19 @@ bool AMatchGameMode::ValidateMove(AUnitBase* U, const FVector& Dest, float& OutS
     const bool bAllowed = (distTTIn <= U->MoveBudgetInches);
     const FColor Col = bAllowed ? FColor::Green : FColor::Red;
 
-    if (AMatchGameState* S = GS())
+    const AMatchGameState* S = GS();
+    if (S && FTabletopDebugDraw::IsEnabled(ETabletopDebugCategory::Move, S->bDrawDebugHelpers))
     {
-        S->Multicast_DrawSphere(Start, 25.f, 16, Col, 10.f, 2.f);
-        S->Multicast_DrawSphere(Dest,  25.f, 16, Col, 10.f, 2.f);
-        S->Multicast_DrawLine  (Start, Dest, Col, 10.f, 2.f);
+        FTabletopDebugDraw::Sphere(S, Start, 25.f, Col, 10.f, 2.f);
+        FTabletopDebugDraw::Sphere(S, Dest,  25.f, Col, 10.f, 2.f);
+        FTabletopDebugDraw::Line  (S, Start, Dest, Col, 10.f, 2.f);
 
         const FString Msg = FString::Printf(
             TEXT("[MoveCheck] Unit=%s  Dist=%.0f cm (%.1f TT-in)  Budget=%.1f TT-in  Max=%.1f TT-in  Scale=%.2f UE-in/TT-in (%.2f cm/TT-in)  -> %s"),
             *U->GetName(), distCm, distTTIn, U->MoveBudgetInches, U->MoveMaxInches,
             TabletopToUnrealInchScale, cmPerTTI,
             bAllowed ? TEXT("ALLOW") : TEXT("DENY"));
-        S->Multicast_ScreenMsg(Msg, Col, 10.f);
+        FTabletopDebugDraw::ScreenMsg(S, Msg, Col, 10.f);
     }
 
     return bAllowed;
@@ -1237,6 +1580,7 @@ void AMatchGameMode::Handle_MoveUnit(AMatchPlayerController* PC, AUnitBase* Unit
 
     Unit->MoveBudgetInches = FMath::Max(0.f, Unit->MoveBudgetInches - spentTTIn);
     Unit->bMovedThisTurn = true;      // NEW: track moved for Heavy/Assault logic
+    Unit->MarkTurnStateDirty();
 	Emit(ECombatEvent::PreMoveExecute, Unit, nullptr, finalDest);
     Unit->SetActorLocation(finalDest);
 	Unit->NotifyMoveChanged();
@@ -1244,11 +1588,8 @@ void AMatchGameMode::Handle_MoveUnit(AMatchPlayerController* PC, AUnitBase* Unit
 	Unit->ForceNetUpdate();
 	Emit(ECombatEvent::PostMove, Unit, nullptr, finalDest);
 
-	const FVector Center = Unit->GetActorLocation();
-	const FVector ThreatDir = (Unit->CurrentTarget->GetActorLocation() - Center).GetSafeNormal2D(); // or the most threatening direction
-
-	const float BaseRadiusCm = Unit->ModelSpacingApartCm * 0.5f; // rough base radius
-	TArray<FVector> Offs = ComputeCohesiveCoveredFormation(Center, ThreatDir, Unit->ModelsCurrent, BaseRadiusCm);
+	// No covered-formation solve here: the result was never applied or replicated (models keep the
+	// RebuildFormation layout), so it only cost server time on every move
 
 	// Optional: immediately refresh target previews
 	if (S)
@@ -1313,6 +1654,7 @@ void AMatchGameMode::Handle_SelectTarget(AMatchPlayerController* PC, AUnitBase*
             S->ActionPreview.HitMod  = 0;
             S->ActionPreview.SaveMod = 0;
             S->ActionPreview.Cover   = ECoverType::None;
+            S->MarkPreviewDirty();
         }
 
         S->SetGlobalTarget(nullptr);
@@ -1345,6 +1687,7 @@ void AMatchGameMode::Handle_SelectTarget(AMatchPlayerController* PC, AUnitBase*
     S->ActionPreview.HitMod  = static_cast<int8>(HitMod);
     S->ActionPreview.SaveMod = static_cast<int8>(SaveMod);
     S->ActionPreview.Cover   = Cover;
+    S->MarkPreviewDirty();
 
     Attacker->FaceActorInstant(Target);
 
@@ -1384,6 +1727,7 @@ void AMatchGameMode::Handle_SelectFriendly(AMatchPlayerController* PC, AUnitBase
             S->ActionPreview.HitMod   = 0;
             S->ActionPreview.SaveMod  = 0;
             S->ActionPreview.Cover    = ECoverType::None;
+            S->MarkPreviewDirty();
         }
 
         S->SetGlobalTarget(nullptr);
@@ -1416,6 +1760,7 @@ void AMatchGameMode::Handle_SelectFriendly(AMatchPlayerController* PC, AUnitBase
     S->ActionPreview.HitMod   = 0;
     S->ActionPreview.SaveMod  = 0;
     S->ActionPreview.Cover    = ECoverType::None; // keep combat UI neutral
+    S->MarkPreviewDirty();
 
     Attacker->FaceActorInstant(Target);
 
@@ -1432,34 +1777,91 @@ void AMatchGameMode::BroadcastPotentialFriendlies(AUnitBase* Attacker)
 	if (!Attacker) return;
 	AMatchGameState* S = GS(); if (!S) return;
 
-	const float rCm = 12.f * CmPerTabletopInch();
-	const float r2  = rCm * rCm;
-	const FVector src = Attacker->GetActorLocation();
-
 	TArray<AUnitBase*> out;
-	for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
+	if (const UTabletopSpatialIndexSubsystem* Index = UTabletopSpatialIndexSubsystem::Get(this))
 	{
-		AUnitBase* U = *It;
-		if (!U || U->ModelsCurrent <= 0) continue;
-		if (U->OwningPS != Attacker->OwningPS) continue;
-		if (FVector::DistSquared(src, U->GetActorLocation()) > r2) continue;
-		// Optional: skip full-health squads
-		// if (!IsHealable(U)) continue;
-		out.Add(U);
+		FUnitSpatialFilter F;
+		F.Team = Attacker->OwningPS;
+		Index->QueryRadius(Attacker->GetActorLocation(), 12.f * CmPerTabletopInch(), F, out);
 	}
+	// Optional: skip full-health squads
+	// out.RemoveAll([](AUnitBase* U){ return !IsHealable(U); });
 	S->Multicast_SetPotentialTargets(out);
 }
 
 FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
-	AUnitBase* Attacker, AUnitBase* Target, const TCHAR* DebugPrefix)
+	AUnitBase* Attacker, AUnitBase* Target, const TCHAR* DebugPrefix, TFunction<void(bool bFired)> OnResolved)
 {
 	FShotResolveResult Out;
 	if (!HasAuthority() || !Attacker || !Target) return Out;
 	if (Attacker->ModelsCurrent <= 0 || Target->ModelsCurrent <= 0) return Out;
 
+	if (!bAsyncCoverTraces)
+	{
+		FCoverQueryResult CoverQ;
+		QueryCoverWithActor(Attacker, Target, CoverQ.HitMod, CoverQ.SaveMod, CoverQ.Type, CoverQ.Primary, &CoverQ.CoverHits);
+		Out = FinishRangedAttack_Internal(Attacker, Target, DebugPrefix, CoverQ);
+		if (OnResolved) OnResolved(true);
+		return Out;
+	}
+
+	// Nothing moved since the preview/last shot traced this pair: no traces, resolve right away
+	FCoverQueryResult Cached;
+	if (FindCachedCover(Attacker, Target, Cached))
+	{
+		Out = FinishRangedAttack_Internal(Attacker, Target, DebugPrefix, Cached);
+		if (OnResolved) OnResolved(true);
+		return Out;
+	}
+
+	// One shot in flight per attacker while its cover batch is out
+	if (PendingShotAttackers.Contains(Attacker)) return Out;
+	PendingShotAttackers.Add(Attacker);
+
+	// Cover rays go out as one async batch; the rest of the shot runs when the last result lands (next frame).
+	// Damage/FX are timer-delayed anyway, so the extra frame isn't visible.
+	// The phase/turn it was fired in is remembered so the callback can refuse a shot whose window closed meanwhile
+	const FString Prefix = DebugPrefix ? DebugPrefix : TEXT("[Shot]");
+	TWeakObjectPtr<AUnitBase> WeakAttacker(Attacker), WeakTarget(Target);
+	const AMatchGameState* IssueGS = GS();
+	const EMatchPhase IssuePhase     = IssueGS ? IssueGS->Phase : EMatchPhase::Battle;
+	const ETurnPhase  IssueTurnPhase = IssueGS ? IssueGS->TurnPhase : ETurnPhase::Shoot;
+	const TWeakObjectPtr<APlayerState> IssueTurn = IssueGS ? IssueGS->CurrentTurn : nullptr;
+	QueryCoverAsync(Attacker, Target, [this, WeakAttacker, WeakTarget, Prefix, IssuePhase, IssueTurnPhase, IssueTurn, OnResolved = MoveTemp(OnResolved)](const FCoverQueryResult& CoverQ)
+	{
+		PendingShotAttackers.Remove(WeakAttacker);
+
+		auto Refuse = [&OnResolved]() { if (OnResolved) OnResolved(false); };
+
+		AUnitBase* A = WeakAttacker.Get();
+		AUnitBase* T = WeakTarget.Get();
+		if (!A || !T) { Refuse(); return; }
+
+		// Same checks the handler ran when the shot was requested; anything could have changed in the frame between
+		const AMatchGameState* S = GS();
+		if (!S || S->Phase != IssuePhase || S->TurnPhase != IssueTurnPhase || S->CurrentTurn != IssueTurn.Get()) { Refuse(); return; }
+		if (!ValidateShoot(A, T)) { Refuse(); return; }
+
+		FinishRangedAttack_Internal(A, T, *Prefix, CoverQ);
+		if (OnResolved) OnResolved(true);
+	});
+
+	Out.bPending = true;
+	return Out;
+}
+
+FShotResolveResult AMatchGameMode::FinishRangedAttack_Internal(
+	AUnitBase* Attacker, AUnitBase* Target, const TCHAR* DebugPrefix, const FCoverQueryResult& CoverQ)
+{
+	FShotResolveResult Out;
+
 	// Use the currently-equipped weapon
 	const FWeaponProfile& Weapon = Attacker->GetActiveWeaponProfile();
 
+	// Every roll of this attack comes from its own substream of the match seed
+	FCombatDice AttackDice = MatchDice.BeginSubstream(
+		FString::Printf(TEXT("%s %s->%s"), DebugPrefix ? DebugPrefix : TEXT("[Shot]"), *GetNameSafe(Attacker), *GetNameSafe(Target)));
+
 	// ---- build context ----
 	FAttackContext Ctx;
 	Ctx.Attacker          = Attacker;
@@ -1469,22 +1871,28 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 	Ctx.bAttackerMoved    = Attacker->bMovedThisTurn;
 	Ctx.bAttackerAdvanced = Attacker->bAdvancedThisTurn;
 
-	// base numbers
-	const int32 Models = FMath::Max(0, Attacker->ModelsCurrent);
-	Ctx.Attacks   = FMath::Max(0, Weapon.Attacks) * Models;
-	Ctx.HitNeed   = FMath::Clamp(Weapon.SkillToHit, 2, 6);
-	Ctx.WoundNeed = ToWoundTarget(Weapon.Strength, Target->GetToughness());
-	Ctx.AP        = FMath::Max(0, Weapon.AP);
-	Ctx.Damage    = FMath::Max(1, Weapon.Damage);
-
-	// ---- Movement-gated weapon rules ----
-	const bool bHasHeavy   = UWeaponKeywordHelpers::HasKeyword(Weapon, EWeaponKeyword::Heavy);
-	const bool bHasAssault = UWeaponKeywordHelpers::HasKeyword(Weapon, EWeaponKeyword::Assault);
-	const FWeaponKeywordData* RF = UWeaponKeywordHelpers::FindKeyword(Weapon, EWeaponKeyword::RapidFire);
+	// ---- keyword plan: every weapon rule for this shot, worked out once ----
+	FAttackPlanSetup PlanSetup;
+	PlanSetup.AttackerModels    = FMath::Max(0, Attacker->ModelsCurrent);
+	PlanSetup.TargetModels      = FMath::Max(0, Target->ModelsCurrent);
+	PlanSetup.TargetToughness   = Target->GetToughness();
+	PlanSetup.RangeInches       = Ctx.RangeInches;
+	PlanSetup.bAttackerMoved    = Ctx.bAttackerMoved;
+	PlanSetup.bAttackerAdvanced = Ctx.bAttackerAdvanced;
+	const FAttackPlan Plan = FAttackPlan::Build(Weapon, Attacker->GetCompiledKeywords(), PlanSetup);
+
+	// base numbers (inline Heavy / Rapid Fire already folded in by the plan)
+	Ctx.Attacks   = Plan.Attacks;
+	Ctx.HitNeed   = Plan.HitNeed;
+	Ctx.WoundNeed = Plan.WoundNeed;
+	Ctx.AP        = Plan.AP;
+	Ctx.Damage    = Plan.Damage;
+	Ctx.CritHitThreshold   = Plan.CritHitAt;
+	Ctx.CritWoundThreshold = Plan.CritWoundAt;
 
 	// TODO - Disabling block as now action points are the only blocker for shooting - we should not prevent if we get to this point
 	// Assault: allow shooting after Advance; if not Assault and advanced, disallow
-	// if (Ctx.bAttackerAdvanced && !bHasAssault)
+	// if (Ctx.bAttackerAdvanced && !Attacker->GetCompiledKeywords().Has(EWeaponKeyword::Assault))
 	// {
 	// 	if (AMatchGameState* S2 = GS())
 	// 		S2->Multicast_ScreenMsg(
@@ -1494,36 +1902,18 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 	// 	return Out;
 	// }
 
-	// Heavy: +1 to hit if did not move
-	if (bHasHeavy && !Ctx.bAttackerMoved)
-	{
-		Ctx.HitNeed = FMath::Clamp(Ctx.HitNeed - 1, 2, 6);
-	}
-
-	// Rapid Fire X: +X attacks per model at half-range or less
-	if (RF && RF->Value > 0)
-	{
-		const bool bHalfRange = (Ctx.RangeInches <= (float(Weapon.RangeInches) * 0.5f + KINDA_SMALL_NUMBER));
-		if (bHalfRange)
-		{
-			Ctx.Attacks += RF->Value * FMath::Max(0, Attacker->ModelsCurrent);
-		}
-	}
-
 	// Cover baseline (keywords/mods can override some effects like Ignores Cover)
-	int32 HitMod = 0, SaveMod = 0;
-	ECoverType Cover = ECoverType::None;
-	ACoverVolume* PrimaryCover = nullptr;
-	TMap<ACoverVolume*, int32> CoverHits;
-	QueryCoverWithActor(Attacker, Target, HitMod, SaveMod, Cover, PrimaryCover, &CoverHits);
+	int32 HitMod = CoverQ.HitMod, SaveMod = CoverQ.SaveMod;
+	ECoverType Cover = CoverQ.Type;
+	ACoverVolume* PrimaryCover = CoverQ.Primary;
+	TMap<ACoverVolume*, int32> CoverHits = CoverQ.CoverHits;
 
 	Emit(ECombatEvent::PreHitCalc, Attacker, Target);
 	// ===== Stage: PreHitCalc =====
 	{
-		FStageResult K = FKeywordProcessor::BuildForStage(Ctx, ECombatEvent::PreHitCalc);
-		FRollModifiers AMods = Attacker->CollectStageMods(ECombatEvent::PreHitCalc, /*bAsAttacker*/true, Target);
-		FRollModifiers TMods = Target  ->CollectStageMods(ECombatEvent::PreHitCalc, /*bAsAttacker*/false, Attacker);
-		FRollModifiers M = K.ModsNow; M.Accumulate(AMods); M.Accumulate(TMods);
+		FRollModifiers M = Attacker->CollectStageMods(ECombatEvent::PreHitCalc, /*bAsAttacker*/true, Target);
+		M.Accumulate(Target->CollectStageMods(ECombatEvent::PreHitCalc, /*bAsAttacker*/false, Attacker));
+		Plan.FoldStage(ECombatEvent::PreHitCalc, M, &AttackDice);
 
 		Ctx.Attacks += M.AttacksDelta;
 		Ctx.HitNeed  = FMath::Clamp(Ctx.HitNeed + M.HitNeedOffset, 2, 6);
@@ -1535,52 +1925,24 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 		// Apply cover hit mod AFTER keyword offsets (not affected by IgnoresCover)
 		Ctx.HitNeed = FMath::Clamp(Ctx.HitNeed + (HitMod * -1), 2, 6);
 
-		// Roll hits
+		// Roll hits (whole volley in one batch, count hits + crits in one pass)
+		int32 HitCrits = 0;
 		if (bAutoHit)
 		{
 			Ctx.Hits = Ctx.Attacks;
 		}
 		else
 		{
-			for (int32 i=0; i<Ctx.Attacks; ++i)
-			{
-				const int32 r = D6();
-				if (r >= Ctx.HitNeed) ++Ctx.Hits;
-				Ctx.HitRolls.Add((uint8)r);
-			}
+			AttackDice.RollD6Batch(Ctx.Attacks, Ctx.HitRolls);
+			int32 Hits = 0;
+			DiceKernel::CountSuccessAndCrits(Ctx.HitRolls.GetData(), Ctx.HitRolls.Num(),
+											 Ctx.HitNeed, Ctx.CritHitThreshold, Hits, HitCrits);
+			Ctx.Hits += Hits;
 		}
 		Emit(ECombatEvent::PostHitRolls, Attacker, Target);
 
-		// PostHitRolls (Sustained Hits, Lethal Hits)
-		if (Ctx.Weapon)
-		{
-			if (const FWeaponKeywordData* SH =
-					UWeaponKeywordHelpers::FindKeyword(*Ctx.Weapon, EWeaponKeyword::SustainedHits))
-			{
-				int32 Extra = 0;
-				for (uint8 r : Ctx.HitRolls)
-				{
-					if (r >= Ctx.CritHitThreshold)
-					{
-						Extra += FMath::Max(0, SH->Value);
-					}
-				}
-				Ctx.Hits += Extra;
-			}
-
-			if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::LethalHits))
-			{
-				int32 AutoWounds = 0;
-				for (uint8 r : Ctx.HitRolls)
-				{
-					if (r >= Ctx.CritHitThreshold)
-					{
-						++AutoWounds;
-					}
-				}
-				Ctx.Wounds += AutoWounds;
-			}
-		}
+		// PostHitRolls (Sustained Hits, Lethal Hits) - plain count adjustments off the crit count
+		Plan.ApplyHitCrits(HitCrits, Ctx.Hits, Ctx.Wounds);
 	}
 
 	const float CmPerTT = CmPerTabletopInch();
@@ -1639,10 +2001,9 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 	Emit(ECombatEvent::PreWoundCalc, Attacker, Target);
 	// ===== Stage: PreWoundCalc =====
 	{
-		FStageResult K = FKeywordProcessor::BuildForStage(Ctx, ECombatEvent::PreWoundCalc);
-		FRollModifiers AMods = Attacker->CollectStageMods(ECombatEvent::PreWoundCalc, true, Target);
-		FRollModifiers TMods = Target  ->CollectStageMods(ECombatEvent::PreWoundCalc, false, Attacker);
-		FRollModifiers M = K.ModsNow; M.Accumulate(AMods); M.Accumulate(TMods);
+		FRollModifiers M = Attacker->CollectStageMods(ECombatEvent::PreWoundCalc, true, Target);
+		M.Accumulate(Target->CollectStageMods(ECombatEvent::PreWoundCalc, false, Attacker));
+		Plan.FoldStage(ECombatEvent::PreWoundCalc, M, &AttackDice);
 
 		Ctx.WoundNeed = FMath::Clamp(Ctx.WoundNeed + M.WoundNeedOffset, 2, 6);
 
@@ -1650,22 +2011,16 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 		Target  ->ConsumeForStage(ECombatEvent::PreWoundCalc, false);
 
 		const int32 HitsNeedingWound = FMath::Max(0, Ctx.Hits - Ctx.Wounds); // subtract auto-wounds
-		int32 NewWounds = 0;
-		for (int32 i=0; i<HitsNeedingWound; ++i)
-		{
-			const int32 r = D6();
-			if (r >= Ctx.WoundNeed) ++NewWounds;
-			Ctx.WoundRolls.Add((uint8)r);
-		}
+		AttackDice.RollD6Batch(HitsNeedingWound, Ctx.WoundRolls);
+		DiceKernel::RerollFailures(AttackDice, Ctx.WoundRolls, Ctx.WoundNeed, M.bRerollAllWounds, M.bRerollOnesWounds);
+
+		int32 NewWounds = 0, WoundCrits = 0;
+		DiceKernel::CountSuccessAndCrits(Ctx.WoundRolls.GetData(), Ctx.WoundRolls.Num(),
+										 Ctx.WoundNeed, Ctx.CritWoundThreshold, NewWounds, WoundCrits);
 		Ctx.Wounds += NewWounds;
 
 		// Devastating Wounds -> no-save crits
-		if (Ctx.Weapon && UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::DevastatingWounds))
-		{
-			int32 Crits = 0;
-			for (uint8 r : Ctx.WoundRolls) if (r >= Ctx.CritWoundThreshold) ++Crits;
-			Ctx.CritWounds_NoSave += Crits;
-		}
+		Plan.ApplyWoundCrits(WoundCrits, Ctx.CritWounds_NoSave);
 		Emit(ECombatEvent::PostWoundRolls, Attacker, Target);
 	}
 
@@ -1674,10 +2029,9 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 	bool bIgnoreCover = false;
 	int32 InvulnOffset = 0;
 	{
-		FStageResult K = FKeywordProcessor::BuildForStage(Ctx, ECombatEvent::PreSavingThrows);
-		FRollModifiers AMods = Attacker->CollectStageMods(ECombatEvent::PreSavingThrows, true, Target);
-		FRollModifiers TMods = Target  ->CollectStageMods(ECombatEvent::PreSavingThrows, false, Attacker);
-		FRollModifiers M = K.ModsNow; M.Accumulate(AMods); M.Accumulate(TMods);
+		FRollModifiers M = Attacker->CollectStageMods(ECombatEvent::PreSavingThrows, true, Target);
+		M.Accumulate(Target->CollectStageMods(ECombatEvent::PreSavingThrows, false, Attacker));
+		Plan.FoldStage(ECombatEvent::PreSavingThrows, M, &AttackDice);
 
 		Ctx.AP     += M.APDelta;
 		Ctx.Damage += M.DamageDelta;
@@ -1711,8 +2065,9 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 	int32 Unsaved = 0;
 	if (bHasSave)
 	{
-		for (int i=0; i<NormalWounds; ++i)
-			if (D6() < SaveNeed) ++Unsaved; // fail = unsaved
+		TArray<uint8, TInlineAllocator<64>> SaveRolls;
+		AttackDice.RollD6Batch(NormalWounds, SaveRolls);
+		Unsaved = NormalWounds - DiceKernel::CountAtLeast(SaveRolls.GetData(), SaveRolls.Num(), SaveNeed); // fail = unsaved
 	}
 	else
 	{
@@ -1726,6 +2081,7 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 
 	// mark shooter as having shot
 	Attacker->bHasShot = true;
+	Attacker->MarkTurnStateDirty();
 	Attacker->ForceNetUpdate();
 
 	// Face for aesthetics
@@ -1745,10 +2101,9 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 
 	// Allow mods at PostDamageCompute (right before FNP application)
 	{
-		FStageResult K = FKeywordProcessor::BuildForStage(Ctx, ECombatEvent::PostDamageCompute, /*DamageApplied*/ClampedDamage);
-		FRollModifiers AMods = Attacker->CollectStageMods(ECombatEvent::PostDamageCompute, true, Target);
-		FRollModifiers TMods = Target  ->CollectStageMods(ECombatEvent::PostDamageCompute, false, Attacker);
-		FRollModifiers M = K.ModsNow; M.Accumulate(AMods); M.Accumulate(TMods);
+		FRollModifiers M = Attacker->CollectStageMods(ECombatEvent::PostDamageCompute, true, Target);
+		M.Accumulate(Target->CollectStageMods(ECombatEvent::PostDamageCompute, false, Attacker));
+		Plan.FoldStage(ECombatEvent::PostDamageCompute, M, &AttackDice);
 
 		FnpTN = FMath::Clamp(FnpTN + M.FnpNeedOffset, 2, 7); // NEW
 
@@ -1756,7 +2111,7 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 		Target  ->ConsumeForStage(ECombatEvent::PostDamageCompute, false);
 	}
 
-	const int32 FinalDamage = ApplyFeelNoPain(ClampedDamage, FnpTN);
+	const int32 FinalDamage = ApplyFeelNoPain(ClampedDamage, FnpTN, AttackDice);
 	Emit(ECombatEvent::PostDamageCompute, Attacker, Target);
 
 	// Debug / FX
@@ -1804,10 +2159,15 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 
 	// ===== Stage: PostResolveAttack =====
 	{
-		FStageResult K = FKeywordProcessor::BuildForStage(Ctx, ECombatEvent::PostResolveAttack, /*DamageApplied*/ClampedDamage);
-		FRollModifiers AMods = Attacker->CollectStageMods(ECombatEvent::PostResolveAttack, true, Target);
-		FRollModifiers TMods = Target  ->CollectStageMods(ECombatEvent::PostResolveAttack, false, Attacker);
-		FRollModifiers M = K.ModsNow; M.Accumulate(AMods); M.Accumulate(TMods);
+		FRollModifiers M = Attacker->CollectStageMods(ECombatEvent::PostResolveAttack, true, Target);
+		M.Accumulate(Target->CollectStageMods(ECombatEvent::PostResolveAttack, false, Attacker));
+
+		// HAZARDOUS: D6 per model; each 6 kills exactly one model (no overkill)
+		M.MortalDamageImmediateToOwner += Plan.RollHazardousSpill(AttackDice,
+			Attacker->ModelsCurrent, Attacker->GetWoundsPerModel(), Attacker->WoundsPool);
+
+		TArray<FUnitModifier> GrantsToAttacker, GrantsToTarget;
+		Plan.CollectGrants(ClampedDamage, GrantsToAttacker, GrantsToTarget);
 
 		if (M.MortalDamageImmediateToOwner    > 0) { Attacker->ApplyMortalDamage_Server(M.MortalDamageImmediateToOwner); }
 		if (M.MortalDamageImmediateToOpponent > 0) { Target  ->ApplyMortalDamage_Server(M.MortalDamageImmediateToOpponent); }
@@ -1815,8 +2175,8 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 		Attacker->ConsumeForStage(ECombatEvent::PostResolveAttack, true);
 		Target  ->ConsumeForStage(ECombatEvent::PostResolveAttack, false);
 
-		for (const FUnitModifier& G : K.GrantsToAttacker) Attacker->AddUnitModifier(G);
-		for (const FUnitModifier& G : K.GrantsToTarget)   Target  ->AddUnitModifier(G);
+		for (const FUnitModifier& G : GrantsToAttacker) Attacker->AddUnitModifier(G);
+		for (const FUnitModifier& G : GrantsToTarget)   Target  ->AddUnitModifier(G);
 	}
 
 	// Fill result for optional UI
@@ -1835,8 +2195,6 @@ FShotResolveResult AMatchGameMode::ResolveRangedAttack_Internal(
 		S2->ForceNetUpdate();
 	}
 
-	CoverMemory.Empty(); // clear cover memory to prevent memory growth
-
 	return Out;
 }
 
@@ -1852,13 +2210,35 @@ void AMatchGameMode::Handle_ConfirmShoot(AMatchPlayerController* PC, AUnitBase*
     if (!ValidateShoot(Attacker, Target)) return;
 
 	Emit(ECombatEvent::PreValidateShoot, Attacker, Target);
-    ResolveRangedAttack_Internal(Attacker,Target,TEXT("[Shoot]"));
 
-	if (S->Preview.Attacker == Attacker)
+	// With async cover the shot lands a frame later; the preview/selection stay up until it actually
+	// fired, and a refused shot just hands the client a UI refresh so it can pick again
+	TWeakObjectPtr<AMatchPlayerController> WeakPC(PC);
+	TWeakObjectPtr<AUnitBase> WeakAttacker(Attacker);
+    ResolveRangedAttack_Internal(Attacker, Target, TEXT("[Shoot]"), [this, WeakPC, WeakAttacker](bool bFired)
+    {
+        if (bFired)
+        {
+            ClearSelectionAfterShot(WeakPC.Get(), WeakAttacker.Get());
+        }
+        else if (AMatchPlayerController* P = WeakPC.Get())
+        {
+            P->Client_KickUIRefresh();
+        }
+    });
+}
+
+void AMatchGameMode::ClearSelectionAfterShot(AMatchPlayerController* PC, AUnitBase* Attacker)
+{
+    AMatchGameState* S = GS();
+    if (!S) return;
+
+	if (Attacker && S->Preview.Attacker == Attacker)
 	{
 		S->Preview.Attacker = nullptr;
 		S->Preview.Target   = nullptr;
 		S->Preview.Phase    = S->TurnPhase;
+		S->MarkPreviewDirty();
 	}
 	
     S->SetGlobalTarget(nullptr);
@@ -1883,31 +2263,12 @@ int32 AMatchGameMode::CountVisibleTargetModels(const AUnitBase* Attacker, const
 
     int32 Visible = 0;
 
-    // NEW: Build a one-time ignore list of ALL units (AUnitBase subclasses)
-    TArray<const AActor*> IgnoreUnits;
-    IgnoreUnits.Reserve(128);
-    for (TActorIterator<AUnitBase> It(World); It; ++It)
-    {
-        if (const AUnitBase* U = *It)
-        {
-            IgnoreUnits.Add(U);
-        }
-    }
+    // params that ignore ALL units (attacker/target included); cached until a unit spawns/dies
+    const FCollisionQueryParams& Params = GetUnitIgnoreParams(EUnitIgnoreTrace::LOS);
 
-    for (int32 j = 0; j < Target->ModelMeshes.Num(); ++j)
+    for (int32 j = 0; j < Target->GetNumModelVisuals(); ++j)
     {
-        UStaticMeshComponent* TC = Target->ModelMeshes[j];
-        if (!IsValid(TC)) continue;
-
-        FVector ModelPoint;
-        if (TC->DoesSocketExist(Target->ImpactSocketName))
-        {
-            ModelPoint = TC->GetSocketTransform(Target->ImpactSocketName, RTS_World).GetLocation();
-        }
-        else
-        {
-            ModelPoint = TC->GetComponentTransform().TransformPosition(Target->ImpactOffsetLocal);
-        }
+        const FVector ModelPoint = Target->GetModelImpactPoint(j);
 
         const int32 ShooterIdx = Attacker->FindBestShooterModelIndex(ModelPoint);
         const FVector From = Attacker->GetMuzzleTransform(ShooterIdx).GetLocation();
@@ -1915,13 +2276,8 @@ int32 AMatchGameMode::CountVisibleTargetModels(const AUnitBase* Attacker, const
 
         FHitResult Hit;
 
-        // NEW: params that ignore ALL units (attacker/target included)
-        FCollisionQueryParams Params(SCENE_QUERY_STAT(UnitLOS), /*bTraceComplex*/ true);
-        Params.AddIgnoredActors(IgnoreUnits);
-
         // Keep your existing LOS channel; just don’t let units block
-        const bool bHit = World->LineTraceSingleByChannel(
-            Hit, From, To, ECollisionChannel::ECC_GameTraceChannel5 /*LOS*/, Params);
+        const bool bHit = World->LineTraceSingleByChannel(Hit, From, To, LosTraceChannel, Params);
 
         if (!bHit)
         {
@@ -1948,6 +2304,7 @@ void AMatchGameMode::Handle_CancelPreview(AMatchPlayerController* PC, AUnitBase*
         S->Preview.Attacker = nullptr;
         S->Preview.Target   = nullptr;
         S->Preview.Phase    = S->TurnPhase;
+        S->MarkPreviewDirty();
         
         S->SetGlobalTarget(nullptr);
     	S->Multicast_ApplySelectionVis(S->SelectedUnitGlobal, S->TargetUnitGlobal);
@@ -1986,6 +2343,19 @@ void AMatchGameMode::BeginPlay()
 {
     Super::BeginPlay();
 
+	// One seed per match; command line wins so a logged seed can be replayed
+	int32 Seed = DiceSeedOverride;
+	FParse::Value(FCommandLine::Get(), TEXT("TabletopDiceSeed="), Seed);
+	MatchDice.SeedMatch(Seed);
+
+	// Keep the cached unit ignore lists honest without walking every unit per trace
+	if (UWorld* World = GetWorld())
+	{
+		bUnitIgnoreParamsDirty = true;
+		ActorSpawnedHandle   = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &AMatchGameMode::HandleActorSpawned));
+		ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &AMatchGameMode::HandleActorDestroyed));
+	}
+
 	if (AMatchGameState* S = GS())
 	{
 		S->CmPerTTInchRep = CmPerTabletopInch();
@@ -1995,10 +2365,22 @@ void AMatchGameMode::BeginPlay()
 	if (AMatchGameState* S = GS())
 	{
 		S->CoverPresetsTable = CoverPresetsTable; // replicate pointer to clients
+		S->MarkCoverDirty();
 		S->ForceNetUpdate();
 	}
 }
 
+void AMatchGameMode::EndPlay(const EEndPlayReason::Type Reason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+	DropPendingCoverQueries();
+	Super::EndPlay(Reason);
+}
+
 void AMatchGameMode::PostLogin(APlayerController* NewPlayer)
 {
     Super::PostLogin(NewPlayer);
@@ -2015,6 +2397,7 @@ void AMatchGameMode::PostLogin(APlayerController* NewPlayer)
 
         if (!S->P1)                    S->P1 = NewTPS;
         else if (!S->P2 && S->P1 != NewTPS) S->P2 = NewTPS;
+        S->MarkPlayersDirty();
 
         S->OnDeploymentChanged.Broadcast();
         S->ForceNetUpdate();
@@ -2023,38 +2406,71 @@ void AMatchGameMode::PostLogin(APlayerController* NewPlayer)
     FinalizePlayerJoin(NewPlayer);
 }
 
-void AMatchGameMode::ResetUnitRoundStateFor(APlayerState* TurnOwner)
+void AMatchGameMode::RegisterTeamUnit(AUnitBase* Unit)
 {
-    if (!HasAuthority() || !TurnOwner) return;
+    if (!HasAuthority() || !Unit) return;
 
-    UWorld* World = GetWorld();
-    for (TActorIterator<AUnitBase> It(World); It; ++It)
+    // InitFromRow can run again (re-init / owner swap); never list a unit twice
+    UnregisterTeamUnit(Unit);
+    if (Unit->OwningPS)
     {
-        if (AUnitBase* U = *It)
-        {
-            if (U->OwningPS == TurnOwner)
-            {
-            	if (U->bOverwatchArmed)
-            	{
-            		Emit(ECombatEvent::Ability_Expired, U); // never triggered -> expired now
-            	}
-
-            	U->SetOverwatchArmed(false);          // <-- server gets an immediate local hide
-            	U->bOverwatchVisibleToEnemies = false; // optional: also clear the telegraph flag
-            	U->ForceNetUpdate();
-            	
-                U->MoveBudgetInches = U->MoveMaxInches;
-                U->bHasShot         = false;
-                U->bMovedThisTurn   = false;
-                U->bAdvancedThisTurn= false;
-
-                U->OnTurnAdvanced(); // decay turn-based unit mods
-                U->ForceNetUpdate();
-            }
-        }
+        TeamUnits.FindOrAdd(Unit->OwningPS).Add(Unit);
+    }
+}
+
+void AMatchGameMode::UnregisterTeamUnit(AUnitBase* Unit)
+{
+    for (auto It = TeamUnits.CreateIterator(); It; ++It)
+    {
+        It.Value().RemoveAll([Unit](const TWeakObjectPtr<AUnitBase>& W) { return !W.IsValid() || W.Get() == Unit; });
+        if (It.Value().Num() == 0) It.RemoveCurrent();
     }
 }
 
+void AMatchGameMode::GetTeamUnits(const APlayerState* Team, TArray<AUnitBase*>& Out) const
+{
+    Out.Reset();
+    ForEachTeamUnit(Team, [&Out](AUnitBase* U) { Out.Add(U); });
+}
+
+void AMatchGameMode::ResetUnitRoundState(AUnitBase* U)
+{
+    if (U->bOverwatchArmed)
+    {
+        Emit(ECombatEvent::Ability_Expired, U); // never triggered -> expired now
+    }
+
+    U->SetOverwatchArmed(false);          // <-- server gets an immediate local hide
+    U->bOverwatchVisibleToEnemies = false; // optional: also clear the telegraph flag
+    U->MarkOverwatchDirty();
+
+    U->MoveBudgetInches = U->MoveMaxInches;
+    U->bHasShot         = false;
+    U->bMovedThisTurn   = false;
+    U->bAdvancedThisTurn= false;
+    U->MarkTurnStateDirty();
+
+    U->OnTurnAdvanced(); // decay turn-based unit mods
+}
+
+void AMatchGameMode::RunPhaseStartPass(APlayerState* TurnOwner, ETurnPhase NewPhase, bool bResetRoundState, bool bApplyAP)
+{
+    if (!HasAuthority() || !TurnOwner) return;
+
+    // Objective controllers are already current (markers track their occupants), so AP can read them straight after the reset
+    ForEachTeamUnit(TurnOwner, [&](AUnitBase* U)
+    {
+        if (bResetRoundState) ResetUnitRoundState(U);
+        if (bApplyAP)         U->ApplyAPPhaseStart(NewPhase);
+        U->ForceNetUpdate();
+    });
+}
+
+void AMatchGameMode::ResetUnitRoundStateFor(APlayerState* TurnOwner)
+{
+    RunPhaseStartPass(TurnOwner, ETurnPhase::Move, /*bResetRoundState=*/true, /*bApplyAP=*/false);
+}
+
 APlayerState* AMatchGameMode::OtherPlayer(APlayerState* PS) const
 {
     if (const AMatchGameState* S = GS())
@@ -2090,6 +2506,7 @@ void AMatchGameMode::CopyRostersFromPlayerStates()
 		// NEW: compute once on the server; replicates to everyone
 		if (S->P1) { FillServerLabelsFor(S->P1, S->P1Remaining); }
 		if (S->P2) { FillServerLabelsFor(S->P2, S->P2Remaining); }
+		S->MarkDeploymentDirty();
 	}
 }
 
@@ -2122,6 +2539,7 @@ bool AMatchGameMode::DecrementOne(APlayerState* PS, FName UnitId, int32 WeaponIn
 		{
 			R[Idx].Count -= 1;
 			if (R[Idx].Count <= 0) R.RemoveAt(Idx);
+			S->MarkDeploymentDirty();
 			return true;
 		}
 	}
@@ -2237,6 +2655,7 @@ void AMatchGameMode::HandleRequestDeploy(APlayerController* PC, FName UnitId, co
         }
 
         S->CurrentDeployer = bOtherLeft ? Other : PC->PlayerState.Get();
+        S->MarkDeploymentDirty();
 
         S->OnDeploymentChanged.Broadcast();
         S->ForceNetUpdate();
@@ -2248,6 +2667,7 @@ void AMatchGameMode::FinishDeployment()
     if (AMatchGameState* S = GS())
     {
         S->bDeploymentComplete = true;
+        S->MarkDeploymentDirty();
         S->OnDeploymentChanged.Broadcast();
         S->ForceNetUpdate();
     }
@@ -2268,6 +2688,8 @@ void AMatchGameMode::HandleStartBattle(APlayerController* PC)
         S->TurnPhase   = ETurnPhase::Move;
 
         S->CurrentTurn = S->CurrentDeployer;
+        S->MarkDeploymentDirty();
+        S->MarkMatchDirty();
 
     	if (S->P1 && S->P2 /*&& !bCoverPresetsApplied*/)
     	{
@@ -2276,8 +2698,6 @@ void AMatchGameMode::HandleStartBattle(APlayerController* PC)
     		bCoverPresetsApplied = true;
     	}
 
-        ResetUnitRoundStateFor(S->CurrentTurn);
-
         S->SetGlobalSelected(nullptr);
         S->SetGlobalTarget(nullptr);
         S->Multicast_ClearPotentialTargets();
@@ -2288,14 +2708,8 @@ void AMatchGameMode::HandleStartBattle(APlayerController* PC)
     	Emit(ECombatEvent::Turn_Begin, /*Src=*/nullptr);     // optional: pass a unit owned by CurrentTurn if you prefer
     	Emit(ECombatEvent::Phase_Begin);                     // Move phase begins
 
-        // Recalc objectives ONCE, then award Move-phase AP (with Round1/Move guard inside unit)
-        for (TActorIterator<AObjectiveMarker> It(GetWorld()); It; ++It)
-            if (AObjectiveMarker* Obj = *It) Obj->RecalculateControl();
-
-        for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
-            if (AUnitBase* U = *It)
-                if (U->OwningPS == S->CurrentTurn)
-                    U->ApplyAPPhaseStart(ETurnPhase::Move);
+        // Reset + Move-phase AP (with Round1/Move guard inside unit) in one pass, same order as every later turn start
+        RunPhaseStartPass(S->CurrentTurn, ETurnPhase::Move, /*bResetRoundState=*/true);
 
         S->OnDeploymentChanged.Broadcast();
         S->ForceNetUpdate();
@@ -2313,32 +2727,21 @@ void AMatchGameMode::HandleEndPhase(APlayerController* PC)
     if (!S || S->Phase != EMatchPhase::Battle) return;
     if (PC->PlayerState != S->CurrentTurn) return;
 
+    // Shots still waiting on their cover batch belong to the phase that's ending
+    DropPendingCoverQueries();
+
     S->SetGlobalSelected(nullptr);
     S->SetGlobalTarget(nullptr);
     S->Multicast_ClearPotentialTargets();
 	S->Multicast_ApplySelectionVis(S->SelectedUnitGlobal, S->TargetUnitGlobal);
 
-    auto ApplyPhaseStartAP = [&](APlayerState* TurnOwner, ETurnPhase NewPhase)
-    {
-        // 1) Refresh objective controllers once
-        for (TActorIterator<AObjectiveMarker> It(GetWorld()); It; ++It)
-            if (AObjectiveMarker* Obj = *It) Obj->RecalculateControl();
-
-        // 2) Apply per-unit AP start logic
-        for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
-        {
-            AUnitBase* U = *It;
-            if (!U || U->OwningPS != TurnOwner) continue;
-            U->ApplyAPPhaseStart(NewPhase);
-        }
-    };
-
     if (S->TurnPhase == ETurnPhase::Move)
     {
     	Emit(ECombatEvent::Phase_End);
         S->TurnPhase = ETurnPhase::Shoot;
+        S->MarkMatchDirty();
     	Emit(ECombatEvent::Phase_Begin); 
-        ApplyPhaseStartAP(S->CurrentTurn, ETurnPhase::Shoot);
+        RunPhaseStartPass(S->CurrentTurn, ETurnPhase::Shoot, /*bResetRoundState=*/false);
         S->OnDeploymentChanged.Broadcast();
         S->ForceNetUpdate();
         return;
@@ -2354,9 +2757,9 @@ void AMatchGameMode::HandleEndPhase(APlayerController* PC)
     	Emit(ECombatEvent::Turn_Begin);      // new player’s turn begins
     	Emit(ECombatEvent::Phase_Begin);
         S->TurnPhase   = ETurnPhase::Move;
+        S->MarkMatchDirty();
 
-        ResetUnitRoundStateFor(S->CurrentTurn);
-        ApplyPhaseStartAP(S->CurrentTurn, ETurnPhase::Move);
+        RunPhaseStartPass(S->CurrentTurn, ETurnPhase::Move, /*bResetRoundState=*/true);
 
         S->OnDeploymentChanged.Broadcast();
         S->ForceNetUpdate();
@@ -2368,14 +2771,14 @@ void AMatchGameMode::HandleEndPhase(APlayerController* PC)
 	Emit(ECombatEvent::Round_End);
     S->CurrentRound = FMath::Clamp<uint8>(S->CurrentRound + 1, 1, S->MaxRounds);
     S->TurnInRound  = 0;
+    S->MarkMatchDirty();
 
     ScoreObjectivesForRound();
     S->OnDeploymentChanged.Broadcast();
     S->ForceNetUpdate();
 
-    // Per-round decays...
-    for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
-        if (AUnitBase* U = *It) U->OnRoundAdvanced();
+    // Per-round decays (both teams; stays ahead of Round_Begin so freshly granted round mods survive)
+    ForEachTeamUnit(nullptr, [](AUnitBase* U) { U->OnRoundAdvanced(); });
 
     // If we've finished the last round, end the game and show summary
     if (S->CurrentRound >= S->MaxRounds)
@@ -2388,13 +2791,13 @@ void AMatchGameMode::HandleEndPhase(APlayerController* PC)
     // Otherwise continue normally
     S->CurrentTurn = OtherPlayer(S->CurrentTurn);
     S->TurnPhase   = ETurnPhase::Move;
+    S->MarkMatchDirty();
 
 	Emit(ECombatEvent::Round_Begin);     // new round starts
 	Emit(ECombatEvent::Turn_Begin);      // new active player’s turn begins
 	Emit(ECombatEvent::Phase_Begin);
     
-    ResetUnitRoundStateFor(S->CurrentTurn);
-    ApplyPhaseStartAP(S->CurrentTurn, ETurnPhase::Move);
+    RunPhaseStartPass(S->CurrentTurn, ETurnPhase::Move, /*bResetRoundState=*/true);
 
     S->SetGlobalSelected(nullptr);
     S->SetGlobalTarget(nullptr);
@@ -2413,16 +2816,11 @@ void AMatchGameMode::ScoreObjectivesForRound()
 
     int32 P1Delta = 0, P2Delta = 0;
 
-    TArray<AObjectiveMarker*> Objectives;
-    for (TActorIterator<AObjectiveMarker> It(GetWorld()); It; ++It)
-        Objectives.Add(*It);
-
-    for (AObjectiveMarker* Obj : Objectives)
+    for (AObjectiveMarker* Obj : S->Objectives)
     {
         if (!Obj) continue;
 
-        Obj->RecalculateControl();
-
+        // cached; markers update as units move/die
         APlayerState* Controller = Obj->GetControllingPlayerState();
         if (!Controller) continue;
 
@@ -2432,24 +2830,71 @@ void AMatchGameMode::ScoreObjectivesForRound()
 
     S->ScoreP1 += P1Delta;
     S->ScoreP2 += P2Delta;
+    S->MarkMatchDirty();
 }
 
 void AMatchGameMode::NotifyUnitTransformChanged(AUnitBase* Changed)
 {
     if (!Changed) return;
-    const float AffectRadius = 4000.f;
+    Changed->BumpTransformVersion(); // stale cover results for this unit
+
     const FVector C = Changed->GetActorLocation();
+    Changed->RefreshNearestEnemyCache();
 
-    for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
+    // Only the mover changed position, so every other unit's nearest enemy is either unchanged,
+    // now the mover (it came closer), or needs one index lookup (it was the mover and it walked away)
+    TArray<AUnitBase*> Units;
+    GetTeamUnits(nullptr, Units);
+    for (AUnitBase* U : Units)
     {
-        AUnitBase* U = *It;
+        if (U == Changed || !U->IsEnemy(Changed)) continue;
+
+        const float D2 = FVector::DistSquared(C, U->GetActorLocation());
+        AUnitBase* Cached = U->GetCachedNearestEnemy();
+
+        if (Cached == Changed)
+        {
+            if (D2 <= U->GetCachedNearestEnemyDistSq()) U->SetCachedNearestEnemy(Changed, D2);
+            else U->RefreshNearestEnemyCache();
+            QueueFacing(U); // same or new nearest, either way its direction moved
+        }
+        else if (!Cached)
+        {
+            if (U->RefreshNearestEnemyCache()) QueueFacing(U);
+        }
+        else if (D2 < U->GetCachedNearestEnemyDistSq())
+        {
+            U->SetCachedNearestEnemy(Changed, D2);
+            QueueFacing(U);
+        }
+    }
+}
+
+void AMatchGameMode::QueueFacing(AUnitBase* Unit)
+{
+    PendingFacing.Add(Unit);
+    if (!bFacingFlushQueued)
+    {
+        bFacingFlushQueued = true;
+        GetWorldTimerManager().SetTimerForNextTick(this, &AMatchGameMode::FlushPendingFacing);
+    }
+}
+
+void AMatchGameMode::FlushPendingFacing()
+{
+    bFacingFlushQueued = false;
+
+    // A unit queued by several moves this frame only turns once, towards whatever is nearest now
+    for (const TWeakObjectPtr<AUnitBase>& W : PendingFacing)
+    {
+        AUnitBase* U = W.Get();
         if (!U) continue;
-        if (!U->IsEnemy(Changed)) continue;
-        if (FVector::DistSquared(C, U->GetActorLocation()) <= AffectRadius * AffectRadius)
+        if (AUnitBase* Enemy = U->GetCachedNearestEnemy())
         {
-            U->FaceNearestEnemyInstant();
+            U->FaceActorInstant(Enemy);
         }
     }
+    PendingFacing.Reset();
 }
 
 void AMatchGameMode::Handle_OverwatchShot(AUnitBase* Attacker, AUnitBase* Target)
@@ -2478,10 +2923,12 @@ void AMatchGameMode::Handle_AdvanceUnit(AMatchPlayerController* PC, AUnitBase* U
 
     // Roll bonus in [1 .. MoveMaxInches] (integers)
     const int32 Max = FMath::Max(1, (int32)FMath::RoundToInt(Unit->MoveMaxInches));
-    const int32 Bonus = FMath::RandRange(1, Max);
+    FCombatDice AdvanceDice = MatchDice.BeginSubstream(FString::Printf(TEXT("[Advance] %s"), *GetNameSafe(Unit)));
+    const int32 Bonus = AdvanceDice.Stream.RandRange(1, Max);
 
     Unit->MoveBudgetInches += (float)Bonus;
     Unit->bAdvancedThisTurn = true;
+    Unit->MarkTurnStateDirty();
 	Emit(ECombatEvent::PostAdvance, Unit);
 	Unit->NotifyMoveChanged();
 	Unit->OnRep_Move();
@@ -2533,10 +2980,11 @@ void AMatchGameMode::BuildMatchSummaryAndReveal()
     Sum.RoundsPlayed = S->CurrentRound;
 
     // Collect all surviving units (both teams), with model counts
-    for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
+    TArray<AUnitBase*> AllUnits;
+    GetTeamUnits(nullptr, AllUnits);
+    for (AUnitBase* U : AllUnits)
     {
-        AUnitBase* U = *It;
-        if (!U || U->ModelsCurrent <= 0) continue;
+        if (U->ModelsCurrent <= 0) continue;
 
         FSurvivorEntry E;
         E.UnitName      = U->UnitName;
@@ -2556,6 +3004,8 @@ void AMatchGameMode::BuildMatchSummaryAndReveal()
     S->FinalSummary = Sum;
     S->bShowSummary = true;
     S->Phase        = EMatchPhase::EndGame;
+    S->MarkSummaryDirty();
+    S->MarkDeploymentDirty();
 
     S->OnDeploymentChanged.Broadcast();
     S->ForceNetUpdate();
@@ -2577,6 +3027,7 @@ void AMatchGameMode::FinalizePlayerJoin(APlayerController* PC)
 
         if (!S->P1)                    S->P1 = TPS;
         else if (!S->P2 && S->P1 != TPS) S->P2 = TPS;
+        S->MarkPlayersDirty();
 
         if (S->P1 && S->P2 && !S->bTeamsAndTurnsInitialized)
         {
@@ -2591,6 +3042,8 @@ void AMatchGameMode::FinalizePlayerJoin(APlayerController* PC)
 
             S->Phase = EMatchPhase::Deployment;
             S->bTeamsAndTurnsInitialized = true;
+            S->MarkDeploymentDirty();
+            S->MarkPlayersDirty();
 
             S->P1->ForceNetUpdate();
             S->P2->ForceNetUpdate();
@@ -2627,9 +3080,9 @@ void AMatchGameMode::ApplyCoverPresetsFromTableOnce()
 	}
 
 	GS->CoverPresetsTable = CoverPresetsTable; // debug/visibility
+	GS->MarkCoverDirty();                       // the early return below would otherwise skip the mark at the end
 
-	TArray<ACoverVolume*> Covers;
-	for (TActorIterator<ACoverVolume> It(W); It; ++It) if (*It) Covers.Add(*It);
+	TArray<ACoverVolume*> Covers; CollectCoverVolumes_AllLevels(W, Covers);
 	if (Covers.Num() == 0)
 	{
 		UE_LOG(LogCoverNet, Warning, TEXT("[GM] No ACoverVolume found; will try again when levels stream in."));
@@ -2716,6 +3169,7 @@ void AMatchGameMode::ApplyCoverPresetsFromTableOnce()
 	}
 
 	// Apply locally (server) and replicate (clients use OnRep to apply)
+	GS->MarkCoverDirty();
 	GS->OnRep_CoverAssignments();
 	GS->ForceNetUpdate();
 
@@ -2733,19 +3187,9 @@ void AMatchGameMode::TallyObjectives_EndOfRound()
     {
         if (!Obj) continue;
 
-        int32 OC_P1 = 0, OC_P2 = 0;
-
-        for (TActorIterator<AUnitBase> It(GetWorld()); It; ++It)
-        {
-            AUnitBase* U = *It;
-            if (!U || !U->OwningPS) continue;
-
-            const int32 OC = U->GetObjectiveControlAt(Obj);
-            if (OC <= 0) continue;
-
-            if (U->OwningPS == GS->P1) OC_P1 += OC;
-            else if (U->OwningPS == GS->P2) OC_P2 += OC;
-        }
+        // cached per-player OC from the marker's occupant set
+        const int32 OC_P1 = Obj->GetObjectiveControlFor(GS->P1);
+        const int32 OC_P2 = Obj->GetObjectiveControlFor(GS->P2);
 
         if (OC_P1 > OC_P2) RoundP1 += Obj->PointsPerRound;
         else if (OC_P2 > OC_P1) RoundP2 += Obj->PointsPerRound;
@@ -2759,6 +3203,7 @@ void AMatchGameMode::TallyObjectives_EndOfRound()
 
     GS->ScoreP1 += RoundP1;
     GS->ScoreP2 += RoundP2;
+    GS->MarkMatchDirty();
 
     GS->OnDeploymentChanged.Broadcast();
 }
@@ -6,8 +6,12 @@
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameStateBase.h"
 #include "Net/UnrealNetwork.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
 #include "Tabletop/AbiltyEventSubsystem.h"
 #include "Tabletop/ArmyData.h"
+#include "Tabletop/CombatDice.h"
+#include "Tabletop/TabletopDebugDraw.h"
 #include "Tabletop/Actors/CoverVolume.h"
 #include "Tabletop/Actors/UnitAction.h"
 
@@ -19,6 +23,7 @@ class ANetDebugTextActor;
 
 class AMatchPlayerController;
 class AUnitBase;
+class AObjectiveMarker;
 
 USTRUCT()
 struct FCoverPairKey
@@ -88,19 +93,13 @@ struct FCoverPresetRow : public FTableRowBase
 
 FORCEINLINE uint32 GetTypeHash(const FCoverPairKey& K)
 {
-	return ::PointerHash(K.A.Get()) ^ (3u * ::PointerHash(K.T.Get()));
+	// Weak-pointer hash (index + serial) stays stable after a unit dies, so stale keys can still be found and pruned
+	return HashCombine(GetTypeHash(K.A), 3u * GetTypeHash(K.T));
 }
 
-USTRUCT()
-struct FCoverPairCache
-{
-	GENERATED_BODY()
-	UPROPERTY() float LastFraction = 0.f;
-	UPROPERTY() ECoverType LastType = ECoverType::None;
-};
-
 struct FShotResolveResult
 {
+	bool  bPending = false; // async cover query in flight; the shot resolves next frame
 	int32 FinalDamage = 0;
 	int32 Hits = 0;
 	int32 Attacks = 0;
@@ -130,6 +129,61 @@ struct FMatchSummary
 	UPROPERTY(BlueprintReadOnly) int32 RoundsPlayed = 0;
 };
 
+// One cover ray: attacker muzzle -> target model point (ModelIdx = index into the target's hit points)
+struct FCoverRay
+{
+	FVector From = FVector::ZeroVector;
+	FVector To   = FVector::ZeroVector;
+	int32   ModelIdx = 0;
+};
+
+struct FCoverQueryResult
+{
+	int32 HitMod  = 0;
+	int32 SaveMod = 0;
+	ECoverType Type = ECoverType::None;
+	ACoverVolume* Primary = nullptr;
+	TMap<ACoverVolume*, int32> CoverHits;
+};
+
+// Versions a cached cover result was computed against; any mismatch means re-trace
+struct FCoverCacheStamp
+{
+	uint32 AttackerVersion = 0;
+	uint32 TargetVersion   = 0;
+	uint32 CoverVersion    = 0;
+
+	bool operator==(const FCoverCacheStamp& O) const
+	{
+		return AttackerVersion == O.AttackerVersion && TargetVersion == O.TargetVersion && CoverVersion == O.CoverVersion;
+	}
+};
+
+// Per attacker/target pair: hysteresis memory plus the last full result
+struct FCoverPairCache
+{
+	float LastFraction = 0.f;
+	ECoverType LastType = ECoverType::None;
+
+	FCoverCacheStamp  Stamp;
+	FCoverQueryResult Result;
+	int32 TraceCount  = 0;   // rays a cache hit saves
+	bool  bHasResult  = false;
+};
+
+// Async cover batch waiting on its trace results
+struct FPendingCoverQuery
+{
+	TWeakObjectPtr<AUnitBase> Attacker;
+	TWeakObjectPtr<AUnitBase> Target;
+	TArray<FCoverRay>  Rays;
+	TArray<FHitResult> Hits;
+	FCoverCacheStamp   Stamp; // versions at submit time; a move mid-flight just makes the entry stale
+	int32 NumModels   = 0;
+	int32 Outstanding = 0;
+	TFunction<void(const FCoverQueryResult&)> OnDone;
+};
+
 UENUM(BlueprintType)
 enum class EMatchPhase : uint8
 {
@@ -239,7 +293,7 @@ public:
 	UFUNCTION(BlueprintPure, Category="Summary")
 	const FMatchSummary& GetFinalSummary() const { return FinalSummary; }
 	
-	void SetFinalSummary(const FMatchSummary& In) { FinalSummary = In; OnRep_FinalSummary(); ForceNetUpdate(); }
+	void SetFinalSummary(const FMatchSummary& In) { FinalSummary = In; MarkSummaryDirty(); OnRep_FinalSummary(); ForceNetUpdate(); }
 	
 	UFUNCTION() void OnRep_Match();
 	
@@ -260,9 +314,13 @@ public:
 	UFUNCTION() void OnRep_Preview();
 	UFUNCTION() void OnRep_ActionPreview();
 
+	// Markers add/remove themselves on BeginPlay/EndPlay, so streamed sublevels' objectives are in here too
 	UPROPERTY(Transient, BlueprintReadOnly)
 	TArray<class AObjectiveMarker*> Objectives;
 
+	void RegisterObjective(AObjectiveMarker* Marker)   { if (Marker) Objectives.AddUnique(Marker); }
+	void UnregisterObjective(AObjectiveMarker* Marker) { Objectives.Remove(Marker); }
+
 	UPROPERTY(ReplicatedUsing=OnRep_Match) uint8 CurrentRound = 1;
 	UPROPERTY(ReplicatedUsing=OnRep_Match) uint8 MaxRounds = 5;
 	UPROPERTY(ReplicatedUsing=OnRep_Match) uint8 TurnInRound = 0; // 0=first player's turn, 1=second
@@ -297,11 +355,20 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type Reason) override;
+
+	// Push-model: after writing replicated state on the server, mark its OnRep group dirty
+	void MarkMatchDirty();       // round / turn / phase / scores
+	void MarkDeploymentDirty();  // Phase, deployer, remaining rosters, bDeploymentComplete
+	void MarkPlayersDirty();     // P1 / P2, bTeamsAndTurnsInitialized
+	void MarkPreviewDirty();     // Preview + ActionPreview
+	void MarkSummaryDirty();     // FinalSummary + bShowSummary
+	void MarkCoverDirty();       // CoverPresetsTable + CoverAssignments
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NetDebug") // Debug Text in world mostly
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NetDebug") // Client side: false = ignore incoming debug draw batches and shot text
 	bool bEnableNetDebugDraw = true;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NetDebug") // Debug lines in world mostly
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="NetDebug") // Shot/cover summaries; also forces the Move debug draws on without tabletop.DebugDraw.Move
 	bool bDrawDebugHelpers = false;
 
 	UPROPERTY(EditAnywhere, Category="NetDebug")
@@ -314,16 +381,16 @@ public:
 	UFUNCTION(NetMulticast, Unreliable)
 	void Multicast_ScreenMsg(const FString& Text, FColor Color = FColor::Yellow, float Time = 3.f, int32 Key = -1);
 
-	// World text at a 3D location
-	UFUNCTION(NetMulticast, Unreliable)
-	void Multicast_DrawWorldText(const FVector& WorldLoc, const FString& Text, FColor Color = FColor::Black, float Time = 3.f, float FontScale = 1.f);
+	// Server: FTabletopDebugDraw queues here, everything queued this frame goes out in one batch next tick
+	void QueueDebugPrim(FTabletopDebugPrim&& Prim);
+	void FlushDebugPrims();
 
-	// Lines & spheres (works in packaged builds)
+	// Lines, spheres, world text and screen messages for one frame (lines go through the line batcher, so packaged builds draw too)
 	UFUNCTION(NetMulticast, Unreliable)
-	void Multicast_DrawLine(const FVector& Start, const FVector& End, FColor Color, float Time = 5.f, float Thickness = 2.f);
+	void Multicast_DebugDrawBatch(const TArray<FTabletopDebugPrim>& Prims);
 
-	UFUNCTION(NetMulticast, Unreliable)
-	void Multicast_DrawSphere(const FVector& Center, float Radius, int32 Segments, FColor Color, float Time = 5.f, float Thickness = 2.f);
+	TArray<FTabletopDebugPrim> PendingDebugPrims;
+	bool bDebugFlushQueued = false;
 
 	UFUNCTION(NetMulticast, Unreliable)
 	void Multicast_SetPotentialTargets(const TArray<AUnitBase*>& NewPotentials);
@@ -355,7 +422,7 @@ class TABLETOP_API AMatchGameMode : public AGameModeBase
 	GENERATED_BODY()
 public:
 	UAbilityEventSubsystem* AbilityBus(UWorld* W);
-	int32 ApplyFeelNoPain(int32 IncomingDamage, int32 FnpTN);
+	int32 ApplyFeelNoPain(int32 IncomingDamage, int32 FnpTN, FCombatDice& Dice);
 	AMatchGameMode();
 	virtual void HandleSeamlessTravelPlayer(AController*& C) override;
 
@@ -380,9 +447,16 @@ public:
 
 	UFUNCTION(exec)
 	void CoverPreset_Dump();
-	
-	UPROPERTY(Transient)
-	TMap<FCoverPairKey, FCoverPairCache> CoverMemory;
+
+	UFUNCTION(exec)
+	void CoverCache_Dump();
+
+	// Cover results persist across previews/confirm/shots until a unit or the cover layout changes
+	mutable TMap<FCoverPairKey, FCoverPairCache> CoverMemory;
+
+	// Bumped whenever cover changes state or goes away (see ACoverVolume::RecomputeFromHealth)
+	void BumpCoverWorldVersion() { ++CoverWorldVersion; }
+	uint32 GetCoverWorldVersion() const { return CoverWorldVersion; }
 
 	UPROPERTY(EditDefaultsOnly, Category="Cover|Query")
 	bool bExhaustiveCoverCross = true;  // false = nearest-N (fast), true = all attacker×target pairs
@@ -405,6 +479,15 @@ public:
 	bool QueryCover(class AUnitBase* Attacker, class AUnitBase* Target,
 					int32& OutHitMod, int32& OutSaveMod, ECoverType& OutType) const;
 
+	// Same query, but all rays go through AsyncLineTraceByChannel as one batch; OnDone runs on the
+	// game thread once every result is in (next frame). Always traces; check FindCachedCover first.
+	void QueryCoverAsync(AUnitBase* Attacker, AUnitBase* Target, TFunction<void(const FCoverQueryResult&)>&& OnDone);
+
+	// true = the shot waits a frame for one async cover batch (re-checked against phase/turn/ValidateShoot when it lands).
+	// false = trace cover synchronously inside ResolveRangedAttack_Internal (old behaviour)
+	UPROPERTY(EditDefaultsOnly, Category="Cover|Query")
+	bool bAsyncCoverTraces = true;
+
 	UFUNCTION()
 	void ApplyDelayedCoverDamage(ACoverVolume* Cover, float Damage, FVector DebugLoc, FString DebugMsg);
 
@@ -417,7 +500,11 @@ public:
 	// Fill ServerDisplayLabel for every row in an array
 	void  FillServerLabelsFor(class APlayerState* ForPS, TArray<FRosterEntry>& Arr) const;
 
-	FShotResolveResult ResolveRangedAttack_Internal(AUnitBase* Attacker, AUnitBase* Target, const TCHAR* DebugPrefix);
+	// With bAsyncCoverTraces the result comes back bPending and the shot finishes a frame later.
+	// OnResolved (optional) runs once the shot fired (true) or was refused when its traces landed (false).
+	FShotResolveResult ResolveRangedAttack_Internal(AUnitBase* Attacker, AUnitBase* Target, const TCHAR* DebugPrefix,
+													TFunction<void(bool bFired)> OnResolved = nullptr);
+	FShotResolveResult FinishRangedAttack_Internal(AUnitBase* Attacker, AUnitBase* Target, const TCHAR* DebugPrefix, const FCoverQueryResult& CoverQ);
 	
 	// Server RPC endpoints (called by PC server functions)
 	void HandleRequestDeploy(APlayerController* PC, FName UnitId, const FTransform& Where, int32 WeaponIndex);
@@ -425,6 +512,11 @@ public:
 	void HandleEndPhase(class APlayerController* PC);
 	void ScoreObjectivesForRound();
 	void NotifyUnitTransformChanged(AUnitBase* Changed);
+
+	// Authoritative per-team unit lists; units join in Server_InitFromRow and leave when destroyed
+	void RegisterTeamUnit(AUnitBase* Unit);
+	void UnregisterTeamUnit(AUnitBase* Unit);
+	void GetTeamUnits(const APlayerState* Team, TArray<AUnitBase*>& Out) const; // null Team = everyone
 	void Handle_AdvanceUnit(AMatchPlayerController* PC, AUnitBase* Unit);
 	void Handle_OverwatchShot(AUnitBase* Attacker, AUnitBase* Target);
 	
@@ -475,6 +567,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category="Cover")
 	TEnumAsByte<ECollisionChannel> CoverTraceChannel = ECC_GameTraceChannel4;
 
+	// Model meshes ignore this one, so per-model visibility never gets blocked by other units
+	UPROPERTY(EditDefaultsOnly, Category="Cover")
+	TEnumAsByte<ECollisionChannel> LosTraceChannel = ECC_GameTraceChannel5;
+
 	// hard cap to keep perf predictable when sampling per-model
 	UPROPERTY(EditDefaultsOnly, Category="Cover")
 	int32 MaxCoverSamplesPerUnit = 10;
@@ -483,9 +579,15 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category="Cover")
 	float CoverProximityInches = 8.f;
 
-	// NEW: toggle draw-debug lines/text for cover traces
+	// Forces the cover ray lines/text on without tabletop.DebugDraw.Cover (never sent in Shipping)
 	UPROPERTY(EditDefaultsOnly, Category="Cover|Debug")
-	bool bDebugCoverTraces = true;
+	bool bDebugCoverTraces = false;
+
+	// Match dice. 0 = random seed per match; set (or pass -TabletopDiceSeed=N) to replay a match's rolls.
+	UPROPERTY(EditDefaultsOnly, Category="Dice")
+	int32 DiceSeedOverride = 0;
+
+	FMatchDiceService MatchDice;
 
 	UDataTable* UnitsForFaction(EFaction Faction) const;
 
@@ -496,11 +598,22 @@ public:
 	
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type Reason) override;
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 
 private:
 	UFUNCTION(BlueprintCallable, Category="Round")
 	void ResetUnitRoundStateFor(APlayerState* TurnOwner);
+
+	// One walk over the turn owner's units at a phase start: round-state reset (new turn) and phase-start AP together
+	void RunPhaseStartPass(APlayerState* TurnOwner, ETurnPhase NewPhase, bool bResetRoundState, bool bApplyAP = true);
+	void ResetUnitRoundState(AUnitBase* U);
+
+	template<typename FuncType>
+	void ForEachTeamUnit(const APlayerState* Team, FuncType&& Func) const;
+
+	using FTeamUnitList = TArray<TWeakObjectPtr<AUnitBase>>;
+	TMap<TObjectKey<APlayerState>, FTeamUnitList> TeamUnits;
 	
 	AMatchGameState* GS() const { return GetGameState<AMatchGameState>(); }
 
@@ -510,6 +623,53 @@ private:
 	float TabletopToUnrealInchScale = 20.f; // 1 tabletop inch == 20 UE inches (exact). Use 19.685 for 50 cm/in.
 	
 	bool CanDeployAt(APlayerController* PC, const FVector& WorldLocation) const;
+
+	// ---- cover query internals (shared by the sync and async paths) ----
+	const FCollisionQueryParams& MakeCoverTraceParams() const;
+	int32 BuildCoverRays(const AUnitBase* Attacker, const AUnitBase* Target, TArray<FCoverRay>& OutRays) const; // returns target model count
+	bool  EvaluateCoverRays(AUnitBase* Attacker, AUnitBase* Target, const TArray<FCoverRay>& Rays,
+							const TArray<FHitResult>& Hits, int32 NumModels, const FCoverCacheStamp& Stamp,
+							FCoverQueryResult& Out) const;
+	bool  AreCoverRaysProvablyClear(const TArray<FCoverRay>& Rays) const; // baked grid says every ray misses all cover
+
+	// ---- nearest-enemy facing (cache lives on the units; re-facing is batched to once per frame) ----
+	void QueueFacing(AUnitBase* Unit);
+	void FlushPendingFacing();
+	TSet<TWeakObjectPtr<AUnitBase>> PendingFacing;
+	bool bFacingFlushQueued = false;
+
+	FCoverCacheStamp MakeCoverStamp(const AUnitBase* Attacker, const AUnitBase* Target) const;
+	bool FindCachedCover(const AUnitBase* Attacker, const AUnitBase* Target, FCoverQueryResult& Out) const;
+	void PruneCoverMemory() const;
+
+	uint32 CoverWorldVersion = 0;
+	mutable bool   bCoverMemoryNeedsPrune = false;
+	mutable uint64 CoverCacheHits   = 0;
+	mutable uint64 CoverCacheMisses = 0;
+	mutable uint64 CoverTracesSaved = 0;
+
+	TMap<uint32, FPendingCoverQuery> PendingCoverQueries;
+	uint32 NextCoverQueryId = 1;
+	TSet<TWeakObjectPtr<AUnitBase>> PendingShotAttackers;
+
+	void OnCoverTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 QueryId);
+	// Forget every query/shot still waiting on traces (phase change, EndPlay); their callbacks never run
+	void DropPendingCoverQueries();
+
+	// Confirmed shot went off: clear the preview, global selection/target and the shooter's client selection
+	void ClearSelectionAfterShot(AMatchPlayerController* PC, AUnitBase* Attacker);
+
+	// ---- cached "ignore every unit" trace params; only rebuilt after a unit spawns or goes away ----
+	enum class EUnitIgnoreTrace : uint8 { Cover, LOS, Formation, Num };
+	const FCollisionQueryParams& GetUnitIgnoreParams(EUnitIgnoreTrace Kind) const;
+	void RebuildUnitIgnoreParams() const;
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+
+	mutable FCollisionQueryParams UnitIgnoreParams[(int32)EUnitIgnoreTrace::Num];
+	mutable bool bUnitIgnoreParamsDirty = true;
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
 	void CopyRostersFromPlayerStates();
 	bool AnyRemainingFor(APlayerState* PS) const;
 	bool DecrementOne(APlayerState* PS, FName UnitId, int32 WeaponIndex);
@@ -1,337 +1,210 @@
 ﻿#include "KeywordProcessor.h"
-#include "WeaponKeywordHelpers.h"
-#include "Actors/UnitBase.h"
+#include "LibraryHelpers.h"
 
-#include "KeywordProcessor.h"
-#include "WeaponKeywordHelpers.h"
-#include "Actors/UnitBase.h"
-
-static bool WithinHalfRange(const FAttackContext& Ctx)
+static bool WithinHalfRange(const FWeaponProfile& W, float RangeInches)
 {
-    return Ctx.RangeInches <= FMath::Max(1.f, Ctx.Weapon->RangeInches * 0.5f);
+    return RangeInches <= FMath::Max(1.f, W.RangeInches * 0.5f);
 }
 
-void FKeywordProcessor::GatherPassiveAndConditional(
-    const FWeaponProfile& W, const FAttackContext& Ctx,
-    ECombatEvent Stage, FRollModifiers& Out)
+FAttackPlan FAttackPlan::Build(const FWeaponProfile& W, const FCompiledKeywordSet& K, const FAttackPlanSetup& S)
 {
-    // HEAVY: +1 to hit if stationary
-    if (Stage == ECombatEvent::PreHitCalc)
+    FAttackPlan P;
+
+    const int32 Models = FMath::Max(0, S.AttackerModels);
+    P.Attacks   = FMath::Max(0, W.Attacks) * Models;
+    P.HitNeed   = FMath::Clamp(W.SkillToHit, 2, 6);
+    P.WoundNeed = CombatMath::ToWoundTarget(W.Strength, S.TargetToughness);
+    P.AP        = FMath::Max(0, W.AP);
+    P.Damage    = FMath::Max(1, W.Damage);
+
+    auto Add = [&P](ECombatEvent Stage, EAttackPlanOp Kind, int32 Value = 0)
     {
-        if (UWeaponKeywordHelpers::HasKeyword(W, EWeaponKeyword::Heavy) && !Ctx.bAttackerMoved)
-        {
-            Out.HitNeedOffset -= 1; // easier to hit
-        }
+        P.Ops.Add({ Stage, Kind, Value });
+    };
 
-        // RAPID FIRE: bonus attacks at ≤ half range  (needs Value => FindKeyword)
-        if (const FWeaponKeywordData* RF = UWeaponKeywordHelpers::FindKeyword(W, EWeaponKeyword::RapidFire))
+    if (K.Mask != 0)
+    {
+        // Heavy and Rapid Fire have always been applied twice on the live path: once straight onto the
+        // base numbers (the GM's inline movement rules) and once more as a PreHitCalc modifier. Kept
+        // as-is on purpose - the plan only saves the re-derivation, rule changes go in separately.
+        const bool  bHeavy = K.Has(EWeaponKeyword::Heavy) && !S.bAttackerMoved;
+        const int32 RF     = K.Value(EWeaponKeyword::RapidFire);
+
+        // HEAVY (inline): +1 to hit if stationary, clamped before any modifiers
+        if (bHeavy)
         {
-            if (WithinHalfRange(Ctx) && RF->Value != 0)
-            {
-                Out.AttacksDelta += RF->Value; // per-volley bump (your DT choice)
-            }
+            P.HitNeed = FMath::Clamp(P.HitNeed - 1, 2, 6);
         }
 
-        // BLAST (deterministic, no RNG here): +Value attacks per 5 enemy models
-        // If Value==0, we leave RNG fallback to BuildForStage (server-authoritative).
-        if (Ctx.Target)
+        // RAPID FIRE X (inline): +X attacks per model at half range or less
+        if (RF > 0 && S.RangeInches <= float(W.RangeInches) * 0.5f + KINDA_SMALL_NUMBER)
         {
-            if (const FWeaponKeywordData* BL = UWeaponKeywordHelpers::FindKeyword(W, EWeaponKeyword::Blast))
-            {
-                if (BL->Value > 0)
-                {
-                    const int32 per = 5; // tune if you expose a DT scalar later
-                    const int32 tgt = FMath::Max(0, Ctx.Target->ModelsCurrent);
-                    Out.AttacksDelta += (tgt / per) * BL->Value;
-                }
-            }
+            P.Attacks += RF * Models;
         }
 
-        // TORRENT/AUTO-HIT (boolean only)
-        if (UWeaponKeywordHelpers::HasKeyword(W, EWeaponKeyword::Torrent))
+        // ===== PreHitCalc =====
+        // HEAVY: +1 to hit if stationary
+        if (bHeavy)
         {
-            Out.bAutoHit = true;
+            Add(ECombatEvent::PreHitCalc, EAttackPlanOp::HitNeedDelta, -1);
         }
-    }
 
-    // ASSAULT: allow shooting after Advance; (else your ValidateShoot can block)
-    if (Stage == ECombatEvent::PreValidateShoot)
-    {
-        if (Ctx.bAttackerAdvanced && !UWeaponKeywordHelpers::HasKeyword(W, EWeaponKeyword::Assault))
+        // RAPID FIRE X: +X attacks per volley at half range (min 1") or less
+        if (RF > 0 && WithinHalfRange(W, S.RangeInches))
         {
-            // mark disallowed if you want; ValidateShoot can also enforce
+            Add(ECombatEvent::PreHitCalc, EAttackPlanOp::AttacksDelta, RF);
         }
-    }
 
-    // TWIN-LINKED: re-roll wound rolls (needs flags => FindKeyword)
-    if (Stage == ECombatEvent::PreWoundCalc)
-    {
-        if (const FWeaponKeywordData* TL = UWeaponKeywordHelpers::FindKeyword(W, EWeaponKeyword::TwinLinked))
+        // BLAST (Value==0 only): the classic D3/D6 by unit size
+        if (K.Has(EWeaponKeyword::Blast) && K.Value(EWeaponKeyword::Blast) == 0)
         {
-            Out.bRerollAllWounds  |= TL->bRerollAllWounds;
-            Out.bRerollOnesWounds |= TL->bRerollOnesWounds || (!TL->bRerollAllWounds); // default to reroll 1s
+            const int32 tgt = FMath::Max(0, S.TargetModels);
+            if (tgt >= 11)      Add(ECombatEvent::PreHitCalc, EAttackPlanOp::ExtraAttackDie, 6);
+            else if (tgt >= 6)  Add(ECombatEvent::PreHitCalc, EAttackPlanOp::ExtraAttackDie, 3);
         }
-    }
 
-    // SHRED: re-roll 1s to wound (boolean only => HasKeyword)
-    if (Stage == ECombatEvent::PreWoundCalc)
-    {
-        if (UWeaponKeywordHelpers::HasKeyword(W, EWeaponKeyword::Shred))
+        if (K.Has(EWeaponKeyword::Torrent))
         {
-            Out.bRerollOnesWounds = true;
+            Add(ECombatEvent::PreHitCalc, EAttackPlanOp::AutoHit);
         }
-    }
 
-    // IGNORES COVER (boolean only)
-    if (Stage == ECombatEvent::PreSavingThrows)
-    {
-        if (UWeaponKeywordHelpers::HasKeyword(W, EWeaponKeyword::IgnoresCover))
+        // ===== PostHitRolls =====
+        const int32 SH = K.Value(EWeaponKeyword::SustainedHits);
+        if (SH > 0)
         {
-            Out.bIgnoreCover = true;
+            Add(ECombatEvent::PostHitRolls, EAttackPlanOp::SustainedHits, SH);
         }
-    }
-
-    // PIERCING: extra AP at ≤ half range (needs Value => FindKeyword)
-    if (Stage == ECombatEvent::PreSavingThrows)
-    {
-        if (const FWeaponKeywordData* P = UWeaponKeywordHelpers::FindKeyword(W, EWeaponKeyword::Piercing))
+        if (K.Has(EWeaponKeyword::LethalHits))
         {
-            if (WithinHalfRange(Ctx) && P->Value > 0)
-            {
-                Out.APDelta += P->Value;
-            }
+            Add(ECombatEvent::PostHitRolls, EAttackPlanOp::LethalHits);
         }
-    }
-}
 
-FStageResult FKeywordProcessor::BuildForStage(const FAttackContext& Ctx, ECombatEvent Stage, int32 DamageApplied)
-{
-    FStageResult R;
-
-    if (Stage == ECombatEvent::PreHitCalc)
-    {
-        // Heavy
-        if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::Heavy) && !Ctx.bAttackerMoved)
+        // ===== PostWoundRolls =====
+        if (K.Has(EWeaponKeyword::DevastatingWounds))
         {
-            R.ModsNow.HitNeedOffset -= 1;
+            Add(ECombatEvent::PostWoundRolls, EAttackPlanOp::DevastatingWounds);
         }
 
-        // Rapid Fire
-        if (const FWeaponKeywordData* RF = UWeaponKeywordHelpers::FindKeyword(*Ctx.Weapon, EWeaponKeyword::RapidFire))
+        // ===== PreSavingThrows =====
+        if (K.Has(EWeaponKeyword::IgnoresCover))
         {
-            if (WithinHalfRange(Ctx) && RF->Value > 0)
-            {
-                R.ModsNow.AttacksDelta += RF->Value;
-            }
+            Add(ECombatEvent::PreSavingThrows, EAttackPlanOp::IgnoreCover);
         }
 
-        // Blast RNG fallback: if Value==0 in DT, use classic D3/D6 scaling by enemy size
-        if (Ctx.Target)
+        // ===== PostResolveAttack =====
+        if (K.Has(EWeaponKeyword::Hazardous))
         {
-            if (const FWeaponKeywordData* BL = UWeaponKeywordHelpers::FindKeyword(*Ctx.Weapon, EWeaponKeyword::Blast))
-            {
-                if (BL->Value == 0)
-                {
-                    const int32 tgt = FMath::Max(0, Ctx.Target->ModelsCurrent);
-                    if (tgt >= 11)      R.ModsNow.AttacksDelta += FMath::RandRange(1,6);
-                    else if (tgt >= 6)  R.ModsNow.AttacksDelta += FMath::RandRange(1,3);
-                }
-            }
+            Add(ECombatEvent::PostResolveAttack, EAttackPlanOp::HazardousSpill);
         }
-
-        // Torrent
-        if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::Torrent))
+        if (K.Has(EWeaponKeyword::Suppressive))
         {
-            R.ModsNow.bAutoHit = true;
+            Add(ECombatEvent::PostResolveAttack, EAttackPlanOp::SuppressOnDamage);
         }
     }
 
-    if (Stage == ECombatEvent::PreSavingThrows)
+    // Ops were added in pipeline order already; index where each stage starts
+    int32 OpIdx = 0;
+    for (int32 s = 0; s < NumStages; ++s)
     {
-        // Ignores Cover
-        if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::IgnoresCover))
-        {
-            R.ModsNow.bIgnoreCover = true;
-        }
+        P.StageStart[s] = (uint8)OpIdx;
+        while (OpIdx < P.Ops.Num() && (int32)P.Ops[OpIdx].Stage == s) ++OpIdx;
     }
+    P.StageStart[NumStages] = (uint8)OpIdx;
+    checkSlow(OpIdx == P.Ops.Num());
 
-    if (Stage == ECombatEvent::PostResolveAttack)
-    {
-        // HAZARDOUS: D6 per model; each 6 kills exactly one model (no overkill).
-        if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::Hazardous) && Ctx.Attacker)
-        {
-            const int32 Models = FMath::Max(0, Ctx.Attacker->ModelsCurrent);
-            int32 Casualties = 0;
-            for (int32 i = 0; i < Models; ++i)
-            {
-                if (FMath::RandRange(1,6) == 6) { ++Casualties; }
-            }
+    return P;
+}
 
-            if (Casualties > 0)
-            {
-                const int32 PerModel     = Ctx.Attacker->GetWoundsPerModel();
-                const int32 TargetModels = FMath::Max(0, Models - Casualties);
-                const int32 TargetPool   = TargetModels * PerModel;
-                const int32 DamageNeeded = FMath::Max(0, Ctx.Attacker->WoundsPool - TargetPool);
+TArrayView<const FAttackPlanOp> FAttackPlan::OpsFor(ECombatEvent Stage) const
+{
+    const int32 s = (int32)Stage;
+    return TArrayView<const FAttackPlanOp>(Ops.GetData() + StageStart[s], StageStart[s + 1] - StageStart[s]);
+}
 
-                if (DamageNeeded > 0)
-                {
-                    // Reuse existing immediate-damage plumbing in your GM:
-                    R.ModsNow.MortalDamageImmediateToOwner += DamageNeeded;
-                }
-            }
-        }
+bool FAttackPlan::HasOp(EAttackPlanOp Kind) const
+{
+    for (const FAttackPlanOp& Op : Ops) if (Op.Kind == Kind) return true;
+    return false;
+}
 
-        // SUPPRESSIVE: if damage landed, give target -1 to hit on their next attacks
-        if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::Suppressive) && DamageApplied > 0)
+int32 FAttackPlan::SumOf(EAttackPlanOp Kind) const
+{
+    int32 Sum = 0;
+    for (const FAttackPlanOp& Op : Ops) if (Op.Kind == Kind) Sum += Op.Value;
+    return Sum;
+}
+
+void FAttackPlan::FoldStage(ECombatEvent Stage, FRollModifiers& M, FCombatDice* Dice) const
+{
+    for (const FAttackPlanOp& Op : OpsFor(Stage))
+    {
+        switch (Op.Kind)
         {
-            FUnitModifier Suppress;
-            Suppress.AppliesAt      = ECombatEvent::PreHitCalc;
-            Suppress.Targeting      = EModifierTarget::OwnerWhenAttacking;
-            Suppress.Mods.HitNeedOffset += +1; // harder to hit
-            Suppress.Expiry         = EModifierExpiry::UntilEndOfTurn;
-            Suppress.TurnsRemaining = 1;
-            R.GrantsToTarget.Add(Suppress);
+            case EAttackPlanOp::AttacksDelta:   M.AttacksDelta  += Op.Value; break;
+            case EAttackPlanOp::HitNeedDelta:   M.HitNeedOffset += Op.Value; break;
+            case EAttackPlanOp::AutoHit:        M.bAutoHit = true;           break;
+            case EAttackPlanOp::IgnoreCover:    M.bIgnoreCover = true;       break;
+            case EAttackPlanOp::ExtraAttackDie:
+                if (Dice) M.AttacksDelta += (int32)Dice->RollDie((uint32)Op.Value);
+                break;
+            default: break;
         }
     }
-
-    return R;
 }
 
-static uint8 RerollIfNeeded(uint8 Roll, bool bRerollAll, bool bRerollOnes, TFunctionRef<uint8()> D6)
+void FAttackPlan::ApplyHitCrits(int32 HitCrits, int32& Hits, int32& AutoWounds) const
 {
-    if (bRerollAll || (bRerollOnes && Roll == 1))
+    if (HitCrits <= 0) return;
+    for (const FAttackPlanOp& Op : OpsFor(ECombatEvent::PostHitRolls))
     {
-        return D6();
+        if (Op.Kind == EAttackPlanOp::SustainedHits) Hits       += HitCrits * Op.Value;
+        else if (Op.Kind == EAttackPlanOp::LethalHits) AutoWounds += HitCrits;
     }
-    return Roll;
 }
 
-void FKeywordProcessor::ApplyStage(ECombatEvent Stage, FAttackContext& Ctx)
+void FAttackPlan::ApplyWoundCrits(int32 WoundCrits, int32& CritNoSave) const
 {
-    FRollModifiers Mods;
-    GatherPassiveAndConditional(*Ctx.Weapon, Ctx, Stage, Mods);
-
-    // Apply generic mods to the live context
-    switch (Stage)
+    if (WoundCrits <= 0) return;
+    for (const FAttackPlanOp& Op : OpsFor(ECombatEvent::PostWoundRolls))
     {
-        case ECombatEvent::PreHitCalc:
-            Ctx.Attacks += Mods.AttacksDelta;
-            Ctx.HitNeed  = FMath::Clamp(Ctx.HitNeed + Mods.HitNeedOffset, 2, 6);
-            if (Mods.bAutoHit)
-            {
-                Ctx.HitRolls.Reset();
-                Ctx.Hits = Ctx.Attacks; // everything hits
-            }
-            break;
-
-        case ECombatEvent::PreWoundCalc:
-        {
-            // apply wound need offsets first (if you ever add any)
-            Ctx.WoundNeed = FMath::Clamp(Ctx.WoundNeed + Mods.WoundNeedOffset, 2, 6);
-
-            // Roll wounds (respect prior auto-wounds from Lethal)
-            const bool bRerollAllWounds  = Mods.bRerollAllWounds;
-            const bool bRerollOnesWounds = Mods.bRerollOnesWounds;
-
-            const int32 HitsNeedingWound = FMath::Max(0, Ctx.Hits - Ctx.Wounds);
-            int32 NewWounds = 0;
-            for (int32 i=0; i<HitsNeedingWound; ++i)
-            {
-                uint8 r = (uint8)FMath::RandRange(1,6);
-                if (r < Ctx.WoundNeed)
-                {
-                    r = RerollIfNeeded(r, bRerollAllWounds, bRerollOnesWounds, [](){ return (uint8)FMath::RandRange(1,6); });
-                }
-                if (r >= Ctx.WoundNeed) ++NewWounds;
-                Ctx.WoundRolls.Add(r);
-            }
-            Ctx.Wounds += NewWounds;
-            break;
-        }
-
-        case ECombatEvent::PreSavingThrows:
-        {
-            // Brutal: +Damage per natural 6 to wound
-            int32 BrutalBonusPer6 = 0;
-            if (const FWeaponKeywordData* BR = UWeaponKeywordHelpers::FindKeyword(*Ctx.Weapon, EWeaponKeyword::Brutal))
-            {
-                BrutalBonusPer6 = (BR->Value != 0) ? BR->Value : 1; // default +1 if unspecified
-            }
-            if (BrutalBonusPer6 != 0)
-            {
-                int32 BrutalSixes = 0;
-                for (uint8 r : Ctx.WoundRolls) if (r == 6) ++BrutalSixes;
-                if (BrutalSixes > 0) Ctx.Damage += BrutalSixes * BrutalBonusPer6;
-            }
-
-            Ctx.AP      += Mods.APDelta;
-            Ctx.Damage  += Mods.DamageDelta;
-            Ctx.bIgnoreCover |= Mods.bIgnoreCover;
-            break;
-        }
-
-        default: break;
+        if (Op.Kind == EAttackPlanOp::DevastatingWounds) CritNoSave += WoundCrits;
     }
+}
 
-    // Keyword-specific transforms that need dice context
-    if (Stage == ECombatEvent::PostHitRolls)
+int32 FAttackPlan::RollHazardousSpill(FCombatDice& Dice, int32 Models, int32 WoundsPerModel, int32 WoundsPool) const
+{
+    int32 Mortals = 0;
+    for (const FAttackPlanOp& Op : OpsFor(ECombatEvent::PostResolveAttack))
     {
-        // SUSTAINED HITS: each crit adds Value extra hits
-        if (const FWeaponKeywordData* SH = UWeaponKeywordHelpers::FindKeyword(*Ctx.Weapon, EWeaponKeyword::SustainedHits))
-        {
-            if (SH->Value > 0)
-            {
-                int32 Extra = 0;
-                for (uint8 r : Ctx.HitRolls)
-                {
-                    if (r >= Ctx.CritHitThreshold)
-                    {
-                        Extra += SH->Value;
-                    }
-                }
-                Ctx.Hits += Extra;
-            }
-        }
+        if (Op.Kind != EAttackPlanOp::HazardousSpill) continue;
 
-        // LETHAL HITS: crits to-hit auto-wound
-        if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::LethalHits))
+        // Each 6 kills exactly one model (no overkill): damage down to the surviving models' pool
+        Models = FMath::Max(0, Models);
+        TArray<uint8, TInlineAllocator<32>> Rolls;
+        const int32 Casualties = DiceKernel::RollAndCount(Dice, Models, 6, Rolls);
+        if (Casualties > 0)
         {
-            int32 AutoWounds = 0;
-            for (uint8 r : Ctx.HitRolls)
-            {
-                if (r >= Ctx.CritHitThreshold)
-                {
-                    ++AutoWounds;
-                }
-            }
-            Ctx.Wounds += AutoWounds; // add now; remaining hits still roll to wound
+            const int32 TargetPool = FMath::Max(0, Models - Casualties) * FMath::Max(1, WoundsPerModel);
+            Mortals += FMath::Max(0, WoundsPool - TargetPool);
         }
     }
+    return Mortals;
+}
 
-    if (Stage == ECombatEvent::PostWoundRolls)
+void FAttackPlan::CollectGrants(int32 DamageApplied, TArray<FUnitModifier>& /*OutToAttacker*/, TArray<FUnitModifier>& OutToTarget) const
+{
+    for (const FAttackPlanOp& Op : OpsFor(ECombatEvent::PostResolveAttack))
     {
-        // DEVASTATING WOUNDS: crits to-wound bypass saves
-        if (UWeaponKeywordHelpers::HasKeyword(*Ctx.Weapon, EWeaponKeyword::DevastatingWounds))
-        {
-            int32 Crits = 0;
-            for (uint8 r : Ctx.WoundRolls) if (r >= Ctx.CritWoundThreshold) ++Crits;
-            Ctx.CritWounds_NoSave += Crits;
-        }
-
-        // RENDING: any crit to-wound increases AP by +Value (default +1) for the volley
-        if (const FWeaponKeywordData* REN = UWeaponKeywordHelpers::FindKeyword(*Ctx.Weapon, EWeaponKeyword::Rending))
+        // SUPPRESSIVE: if damage landed, give target -1 to hit on their next attacks
+        if (Op.Kind == EAttackPlanOp::SuppressOnDamage && DamageApplied > 0)
         {
-            const int32 Inc = (REN->Value != 0) ? REN->Value : 1;
-            for (uint8 r : Ctx.WoundRolls)
-            {
-                if (r >= Ctx.CritWoundThreshold) { Ctx.AP += Inc; break; } // once per volley
-            }
+            FUnitModifier Suppress;
+            Suppress.AppliesAt      = ECombatEvent::PreHitCalc;
+            Suppress.Targeting      = EModifierTarget::OwnerWhenAttacking;
+            Suppress.Mods.HitNeedOffset += +1; // harder to hit
+            Suppress.Expiry         = EModifierExpiry::UntilEndOfTurn;
+            Suppress.TurnsRemaining = 1;
+            OutToTarget.Add(Suppress);
         }
     }
-
-    if (Stage == ECombatEvent::PostResolveAttack)
-    {
-        
-    }
 }
@@ -2,6 +2,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "ArmyData.h"
+#include "CombatDice.h"
 #include "CombatEffects.h"
 #include "WeaponKeywords.h"
 
@@ -39,23 +40,84 @@ struct FAttackContext
 	int32 CritWounds_NoSave = 0;
 };
 
-struct FStageResult
+// One keyword effect, pinned to the pipeline stage that executes it
+enum class EAttackPlanOp : uint8
 {
-	FRollModifiers ModsNow;                // to apply immediately this stage
-	TArray<FUnitModifier> GrantsToAttacker;// future time-boxed mods to add to attacker
-	TArray<FUnitModifier> GrantsToTarget;  // future time-boxed mods to add to target
+	AttacksDelta,       // PreHitCalc: +Value attacks (Rapid Fire per volley)
+	ExtraAttackDie,     // PreHitCalc: roll a D<Value> and add it to attacks (Blast fallback)
+	HitNeedDelta,       // PreHitCalc: Value added to hit need (Heavy = -1)
+	AutoHit,            // PreHitCalc: Torrent
+	SustainedHits,      // PostHitRolls: +Value hits per crit
+	LethalHits,         // PostHitRolls: crits auto-wound
+	DevastatingWounds,  // PostWoundRolls: crits skip saves
+	IgnoreCover,        // PreSavingThrows
+	HazardousSpill,     // PostResolveAttack: D6 per attacking model, each 6 costs a model
+	SuppressOnDamage,   // PostResolveAttack: target gets +1 to its hit need next turn if damage landed
 };
 
-class FKeywordProcessor
+struct FAttackPlanOp
 {
-public:
-	static void GatherPassiveAndConditional(const FWeaponProfile& Wpn,
-											const FAttackContext& Ctx,
-											ECombatEvent Stage,
-											FRollModifiers& OutMods);
-
-	// Convenience pass that applies common keywords at each stage
-	static void ApplyStage(ECombatEvent Stage, FAttackContext& Ctx);
-	
-	static FStageResult BuildForStage(const FAttackContext& Ctx, ECombatEvent Stage, int32 DamageAppliedOptional=0);
+	ECombatEvent  Stage = ECombatEvent::PreHitCalc;
+	EAttackPlanOp Kind  = EAttackPlanOp::AttacksDelta;
+	int32         Value = 0;
+};
+
+// Situational inputs the plan depends on (everything else comes from the weapon)
+struct FAttackPlanSetup
+{
+	int32 AttackerModels  = 0;
+	int32 TargetModels    = 0;
+	int32 TargetToughness = 4;
+	float RangeInches     = 0.f;
+	bool  bAttackerMoved    = false;
+	bool  bAttackerAdvanced = false;
+};
+
+/**
+ * Every keyword effect of one attack, worked out once from the weapon + situation and stored
+ * as an ordered per-stage op list. The resolver folds each stage's ops in as it reaches it;
+ * nothing looks at keywords after Build. Unit modifiers are still collected live per stage.
+ */
+struct TABLETOP_API FAttackPlan
+{
+	// Base numbers off the weapon profile, plus the inline Heavy / Rapid Fire the GM always did up front
+	int32 Attacks   = 0;
+	int32 HitNeed   = 4;
+	int32 WoundNeed = 4;
+	int32 AP        = 0;
+	int32 Damage    = 1;
+
+	uint8 CritHitAt   = 6;
+	uint8 CritWoundAt = 6;
+
+	static FAttackPlan Build(const FWeaponProfile& Weapon, const FCompiledKeywordSet& Keywords, const FAttackPlanSetup& Setup);
+
+	TArrayView<const FAttackPlanOp> OpsFor(ECombatEvent Stage) const;
+
+	bool  HasOp(EAttackPlanOp Kind) const;
+	int32 SumOf(EAttackPlanOp Kind) const;
+
+	// --- executors; each only walks its own stage's ops ---
+
+	// Pre-roll stages: fold threshold/attack/reroll/cover ops into this stage's modifiers.
+	// Dice may be null (previews): ExtraAttackDie is then left for the caller to model.
+	void FoldStage(ECombatEvent Stage, FRollModifiers& InOut, FCombatDice* Dice) const;
+
+	// PostHitRolls: Sustained adds hits, Lethal turns crits into auto-wounds
+	void ApplyHitCrits(int32 HitCrits, int32& InOutHits, int32& InOutAutoWounds) const;
+
+	// PostWoundRolls: Devastating off the wound crit count
+	void ApplyWoundCrits(int32 WoundCrits, int32& InOutCritNoSave) const;
+
+	// PostResolveAttack: mortal damage the attacker takes from Hazardous (0 if none)
+	int32 RollHazardousSpill(FCombatDice& Dice, int32 Models, int32 WoundsPerModel, int32 WoundsPool) const;
+
+	// PostResolveAttack: time-boxed modifiers this attack hands out
+	void CollectGrants(int32 DamageApplied, TArray<FUnitModifier>& OutToAttacker, TArray<FUnitModifier>& OutToTarget) const;
+
+private:
+	static constexpr int32 NumStages = (int32)ECombatEvent::Unit_Moved + 1;
+
+	TArray<FAttackPlanOp, TInlineAllocator<12>> Ops; // sorted by stage
+	uint8 StageStart[NumStages + 1] = {};
 };
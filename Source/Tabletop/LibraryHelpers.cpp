@@ -17,6 +17,19 @@ bool ULibraryHelpers::IsDeployLocationValid(UObject* WorldContextObject, APlayer
 	return ADeploymentZone::IsLocationAllowedForTeam(World, Team, WorldLocation);
 }
 
+bool ULibraryHelpers::AreDeployLocationsValid(UObject* WorldContextObject, APlayerController* PC, const TArray<FVector>& WorldLocations)
+{
+	if (!WorldContextObject || !PC) return false;
+	UWorld* World = WorldContextObject->GetWorld();
+	if (!World) return false;
+
+	const ATabletopPlayerState* TPS = PC->GetPlayerState<ATabletopPlayerState>();
+	const int32 Team = TPS ? TPS->TeamNum : 0;
+	if (Team <= 0) return false;
+
+	return ADeploymentZone::AreLocationsAllowedForTeam(World, Team, WorldLocations);
+}
+
 bool ULibraryHelpers::GetDeployHitAndValidity(
 	UObject* WorldContextObject,
 	APlayerController* PC,
@@ -17,6 +17,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Deployment", meta=(WorldContext="WorldContextObject"))
 	static bool IsDeployLocationValid(UObject* WorldContextObject, APlayerController* PC, const FVector& WorldLocation);
 
+	/** True if every location (e.g. each model of a formation) is inside PC's allowed deployment zone(s). */
+	UFUNCTION(BlueprintCallable, Category="Deployment", meta=(WorldContext="WorldContextObject"))
+	static bool AreDeployLocationsValid(UObject* WorldContextObject, APlayerController* PC, const TArray<FVector>& WorldLocations);
+
 	/**
 	 * Do a cursor trace and also return validity.
 	 * Returns true if we hit something; bIsValid says if that point is inside the zone.
@@ -3,4 +3,6 @@
 #include "Tabletop.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogTabletop);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Tabletop, "Tabletop" );
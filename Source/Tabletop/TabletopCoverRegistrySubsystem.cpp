@@ -0,0 +1,369 @@
+#include "TabletopCoverRegistrySubsystem.h"
+
+#include "Components/BoxComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Tabletop/CoverBakeData.h"
+#include "Tabletop/Actors/CoverVolume.h"
+
+// ---------------- FTabletopAABBTree ----------------
+
+int32 FTabletopAABBTree::AllocNode()
+{
+	if (FreeNodes.Num())
+	{
+		const int32 Id = FreeNodes.Pop(EAllowShrinking::No);
+		Nodes[Id] = FNode();
+		return Id;
+	}
+	return Nodes.AddDefaulted();
+}
+
+void FTabletopAABBTree::FreeNode(int32 Id)
+{
+	Nodes[Id] = FNode();
+	FreeNodes.Add(Id);
+}
+
+int32 FTabletopAABBTree::Insert(const FBox& Box, int32 Payload)
+{
+	const int32 Leaf = AllocNode();
+	Nodes[Leaf].Box = Box;
+	Nodes[Leaf].Payload = Payload;
+	InsertLeaf(Leaf);
+	++LeafCount;
+	return Leaf;
+}
+
+void FTabletopAABBTree::Remove(int32 Proxy)
+{
+	if (!Nodes.IsValidIndex(Proxy)) return;
+	RemoveLeaf(Proxy);
+	FreeNode(Proxy);
+	--LeafCount;
+}
+
+void FTabletopAABBTree::Update(int32 Proxy, const FBox& Box)
+{
+	if (!Nodes.IsValidIndex(Proxy)) return;
+	if (Nodes[Proxy].Box == Box) return;
+	RemoveLeaf(Proxy);
+	Nodes[Proxy].Box = Box;
+	InsertLeaf(Proxy);
+}
+
+void FTabletopAABBTree::Reset()
+{
+	Nodes.Reset();
+	FreeNodes.Reset();
+	Root = INDEX_NONE;
+	LeafCount = 0;
+}
+
+void FTabletopAABBTree::InsertLeaf(int32 Leaf)
+{
+	if (Root == INDEX_NONE)
+	{
+		Root = Leaf;
+		Nodes[Root].Parent = INDEX_NONE;
+		return;
+	}
+
+	// Walk down picking the child whose area grows least (classic surface-area heuristic)
+	const FBox LeafBox = Nodes[Leaf].Box;
+	int32 Index = Root;
+	while (!Nodes[Index].IsLeaf())
+	{
+		const FNode& N = Nodes[Index];
+		const float Combined = Area(N.Box + LeafBox);
+		const float Here     = 2.f * Combined;
+		const float Inherit  = 2.f * (Combined - Area(N.Box));
+
+		auto Descend = [&](int32 Child)
+		{
+			const FBox Grown = Nodes[Child].Box + LeafBox;
+			const float Extra = Nodes[Child].IsLeaf() ? 0.f : Area(Nodes[Child].Box);
+			return Area(Grown) - Extra + Inherit;
+		};
+		const float CostL = Descend(N.Left);
+		const float CostR = Descend(N.Right);
+
+		if (Here < CostL && Here < CostR) break;
+		Index = (CostL < CostR) ? N.Left : N.Right;
+	}
+
+	// New parent joins the chosen sibling and the leaf
+	const int32 Sibling   = Index;
+	const int32 OldParent = Nodes[Sibling].Parent;
+	const int32 NewParent = AllocNode();
+	Nodes[NewParent].Parent = OldParent;
+	Nodes[NewParent].Box    = Nodes[Sibling].Box + LeafBox;
+	Nodes[NewParent].Left   = Sibling;
+	Nodes[NewParent].Right  = Leaf;
+	Nodes[Sibling].Parent   = NewParent;
+	Nodes[Leaf].Parent      = NewParent;
+
+	if (OldParent == INDEX_NONE)
+	{
+		Root = NewParent;
+	}
+	else if (Nodes[OldParent].Left == Sibling)
+	{
+		Nodes[OldParent].Left = NewParent;
+	}
+	else
+	{
+		Nodes[OldParent].Right = NewParent;
+	}
+
+	// Refit ancestors
+	for (int32 P = Nodes[NewParent].Parent; P != INDEX_NONE; P = Nodes[P].Parent)
+	{
+		Nodes[P].Box = Nodes[Nodes[P].Left].Box + Nodes[Nodes[P].Right].Box;
+	}
+}
+
+void FTabletopAABBTree::RemoveLeaf(int32 Leaf)
+{
+	if (Leaf == Root)
+	{
+		Root = INDEX_NONE;
+		return;
+	}
+
+	const int32 Parent      = Nodes[Leaf].Parent;
+	const int32 GrandParent = Nodes[Parent].Parent;
+	const int32 Sibling     = (Nodes[Parent].Left == Leaf) ? Nodes[Parent].Right : Nodes[Parent].Left;
+
+	if (GrandParent == INDEX_NONE)
+	{
+		Root = Sibling;
+		Nodes[Sibling].Parent = INDEX_NONE;
+	}
+	else
+	{
+		if (Nodes[GrandParent].Left == Parent) Nodes[GrandParent].Left = Sibling;
+		else                                   Nodes[GrandParent].Right = Sibling;
+		Nodes[Sibling].Parent = GrandParent;
+
+		for (int32 P = GrandParent; P != INDEX_NONE; P = Nodes[P].Parent)
+		{
+			Nodes[P].Box = Nodes[Nodes[P].Left].Box + Nodes[Nodes[P].Right].Box;
+		}
+	}
+
+	FreeNode(Parent);
+	Nodes[Leaf].Parent = INDEX_NONE;
+}
+
+// ---------------- UTabletopCoverRegistrySubsystem ----------------
+
+UTabletopCoverRegistrySubsystem* UTabletopCoverRegistrySubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UTabletopCoverRegistrySubsystem>() : nullptr;
+}
+
+bool UTabletopCoverRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTabletopCoverRegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Optional; maps without a bake just trace as before
+	const FString MapName = UWorld::RemovePIEPrefix(InWorld.GetMapName());
+	CoverBake = LoadObject<UTabletopCoverBakeData>(nullptr, *UTabletopCoverBakeData::ObjectPathForMap(MapName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+	BakedCoverByName.Reset();
+	bBakeTrusted = false;
+
+	if (!CoverBake) return;
+	if (!CoverBake->IsValidBake())
+	{
+		UE_LOG(LogCoverNet, Warning, TEXT("[CoverRegistry] Cover bake for %s is empty or out of date; rerun -run=CoverBake"), *MapName);
+		CoverBake = nullptr;
+		return;
+	}
+
+	for (int32 i = 0; i < CoverBake->Covers.Num(); ++i)
+	{
+		BakedCoverByName.Add(CoverBake->Covers[i].ActorName, i);
+	}
+	bBakeTrusted = true;
+
+	// Anything that registered before us gets checked now
+	for (const FSlot& S : Slots)
+	{
+		FBox B;
+		if (S.Cover.IsValid() && BlockingBounds(S.Cover.Get(), B)) CheckAgainstBake(S.Cover.Get(), B);
+	}
+
+	UE_LOG(LogCoverNet, Log, TEXT("[CoverRegistry] Loaded cover bake for %s: %dx%d cells, %d covers, trusted=%d"),
+		*MapName, CoverBake->Dims.X, CoverBake->Dims.Y, CoverBake->Covers.Num(), bBakeTrusted ? 1 : 0);
+}
+
+void UTabletopCoverRegistrySubsystem::Deinitialize()
+{
+	Slots.Empty();
+	SlotOf.Reset();
+	Tree.Reset();
+	CoverBake = nullptr;
+	BakedCoverByName.Reset();
+	bBakeTrusted = false;
+	Super::Deinitialize();
+}
+
+void UTabletopCoverRegistrySubsystem::CheckAgainstBake(const ACoverVolume* Cover, const FBox& Blocking)
+{
+	if (!bBakeTrusted || !Cover) return;
+
+	// Shrinking is fine (damage only ever removes collision); growing or appearing is not
+	const int32* Idx = BakedCoverByName.Find(Cover->GetFName());
+	const FBox2D Now(FVector2D(Blocking.Min), FVector2D(Blocking.Max));
+	if (Idx && CoverBake->Covers[*Idx].Footprint.ExpandBy(1.f).IsInside(Now)) return;
+
+	bBakeTrusted = false;
+	UE_LOG(LogCoverNet, Warning, TEXT("[CoverRegistry] %s %s its baked footprint; falling back to traces (rebake the map)"),
+		*GetNameSafe(Cover), Idx ? TEXT("outgrew") : TEXT("is missing from"));
+}
+
+bool UTabletopCoverRegistrySubsystem::IsSegmentProvablyClear(const FVector& A, const FVector& B) const
+{
+	const UTabletopCoverBakeData* Bake = GetTrustedBake();
+	return Bake && Bake->IsSegmentClear(A, B);
+}
+
+bool UTabletopCoverRegistrySubsystem::IsCoverProvablyBeyond(const FVector& P, float DistCm) const
+{
+	const UTabletopCoverBakeData* Bake = GetTrustedBake();
+	return Bake && Bake->ClearanceLowerBound(P) > DistCm;
+}
+
+bool UTabletopCoverRegistrySubsystem::BlockingBounds(const ACoverVolume* Cover, FBox& OutBox)
+{
+	OutBox = FBox(ForceInit);
+	if (!Cover) return false;
+
+	// Same components the cover/LOS traces can hit; collision is off entirely in the None state
+	if (Cover->Box && Cover->Box->IsCollisionEnabled())
+	{
+		OutBox += Cover->Box->Bounds.GetBox();
+	}
+	if (Cover->Visual && Cover->Visual->IsCollisionEnabled() && Cover->Visual->GetStaticMesh())
+	{
+		OutBox += Cover->Visual->Bounds.GetBox();
+	}
+	return OutBox.IsValid != 0;
+}
+
+void UTabletopCoverRegistrySubsystem::RegisterCover(ACoverVolume* Cover)
+{
+	if (!Cover) return;
+	if (SlotOf.Contains(Cover))
+	{
+		UpdateCover(Cover);
+		return;
+	}
+
+	FSlot S;
+	S.Cover = Cover;
+	const int32 SlotIdx = Slots.Add(S);
+	SlotOf.Add(Cover, SlotIdx);
+
+	FBox B;
+	if (BlockingBounds(Cover, B))
+	{
+		Slots[SlotIdx].Proxy = Tree.Insert(B, SlotIdx);
+		CheckAgainstBake(Cover, B);
+	}
+}
+
+void UTabletopCoverRegistrySubsystem::UnregisterCover(ACoverVolume* Cover)
+{
+	int32 SlotIdx = INDEX_NONE;
+	if (!SlotOf.RemoveAndCopyValue(Cover, SlotIdx)) return;
+
+	if (Slots[SlotIdx].Proxy != INDEX_NONE)
+	{
+		Tree.Remove(Slots[SlotIdx].Proxy);
+	}
+	Slots.RemoveAt(SlotIdx);
+}
+
+void UTabletopCoverRegistrySubsystem::UpdateCover(ACoverVolume* Cover)
+{
+	const int32* SlotIdx = SlotOf.Find(Cover);
+	if (!SlotIdx) return;
+
+	FSlot& S = Slots[*SlotIdx];
+	FBox B;
+	const bool bBlocking = BlockingBounds(Cover, B);
+	if (bBlocking) CheckAgainstBake(Cover, B);
+
+	if (bBlocking && S.Proxy == INDEX_NONE)       S.Proxy = Tree.Insert(B, *SlotIdx);
+	else if (bBlocking)                           Tree.Update(S.Proxy, B);
+	else if (S.Proxy != INDEX_NONE)             { Tree.Remove(S.Proxy); S.Proxy = INDEX_NONE; }
+}
+
+void UTabletopCoverRegistrySubsystem::GetAllCovers(TArray<ACoverVolume*>& Out) const
+{
+	Out.Reset(Slots.Num());
+	for (const FSlot& S : Slots)
+	{
+		if (ACoverVolume* CV = S.Cover.Get()) Out.Add(CV);
+	}
+}
+
+float UTabletopCoverRegistrySubsystem::FindNearestCover(const FVector& P, float MaxDistCm, ACoverVolume*& OutCover, FVector& OutPointOnSurface) const
+{
+	OutCover = nullptr;
+	OutPointOnSurface = P;
+
+	// Baked clearance says nothing is that close; skip the tree and physics entirely
+	if (MaxDistCm > 0.f && IsCoverProvablyBeyond(P, MaxDistCm)) return -1.f;
+
+	float BestD2 = (MaxDistCm > 0.f) ? MaxDistCm * MaxDistCm : TNumericLimits<float>::Max();
+	bool bFound = false;
+
+	Tree.QueryNearest(P, BestD2, [&](int32 SlotIdx, float /*BoxD2*/) -> float
+	{
+		ACoverVolume* CV = Slots[SlotIdx].Cover.Get();
+		if (!CV || !CV->Box) return BestD2;
+
+		FVector OnSurface;
+		const float D = CV->Box->GetClosestPointOnCollision(P, OnSurface, NAME_None);
+		if (D < 0.f) return BestD2; // no valid body instance
+
+		if (D * D <= BestD2)
+		{
+			BestD2 = D * D;
+			OutCover = CV;
+			OutPointOnSurface = OnSurface;
+			bFound = true;
+		}
+		return BestD2;
+	});
+
+	return bFound ? FMath::Sqrt(BestD2) : -1.f;
+}
+
+void UTabletopCoverRegistrySubsystem::QueryOverlap(const FBox& Box, TArray<ACoverVolume*>& Out) const
+{
+	Out.Reset();
+	Tree.QueryOverlap(Box, [&](int32 SlotIdx)
+	{
+		if (ACoverVolume* CV = Slots[SlotIdx].Cover.Get()) Out.Add(CV);
+	});
+}
+
+void UTabletopCoverRegistrySubsystem::QuerySegment(const FVector& Start, const FVector& End, TArray<ACoverVolume*>& Out) const
+{
+	Out.Reset();
+	Tree.QuerySegment(Start, End, [&](int32 SlotIdx)
+	{
+		if (ACoverVolume* CV = Slots[SlotIdx].Cover.Get()) Out.Add(CV);
+	});
+}
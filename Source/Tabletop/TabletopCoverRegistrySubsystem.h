@@ -0,0 +1,194 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TabletopCoverRegistrySubsystem.generated.h"
+
+class ACoverVolume;
+class UTabletopCoverBakeData;
+
+/**
+ * Small dynamic AABB tree (insert / remove / refit, surface-area insertion heuristic).
+ * Leaves carry an int32 payload; walks prune by node bounds before the caller does anything expensive.
+ */
+class TABLETOP_API FTabletopAABBTree
+{
+public:
+	int32 Insert(const FBox& Box, int32 Payload); // returns proxy id (stable until Remove)
+	void  Remove(int32 Proxy);
+	void  Update(int32 Proxy, const FBox& Box);
+	void  Reset();
+
+	int32 GetPayload(int32 Proxy) const { return Nodes[Proxy].Payload; }
+	const FBox& GetBox(int32 Proxy) const { return Nodes[Proxy].Box; }
+	int32 NumLeaves() const { return LeafCount; }
+
+	// Visit(Payload) for every leaf whose box intersects Box
+	template<typename FVisit> void QueryOverlap(const FBox& Box, FVisit&& Visit) const;
+
+	// Visit(Payload) for every leaf whose box the segment passes through
+	template<typename FVisit> void QuerySegment(const FVector& Start, const FVector& End, FVisit&& Visit) const;
+
+	// Best-first: Visit(Payload, BoxDistSq) -> new best distance^2; nodes farther than the current best are skipped
+	template<typename FVisit> void QueryNearest(const FVector& P, float MaxDistSq, FVisit&& Visit) const;
+
+private:
+	struct FNode
+	{
+		FBox  Box = FBox(ForceInit);
+		int32 Parent  = INDEX_NONE;
+		int32 Left    = INDEX_NONE;
+		int32 Right   = INDEX_NONE;
+		int32 Payload = INDEX_NONE;
+		bool IsLeaf() const { return Left == INDEX_NONE; }
+	};
+
+	TArray<FNode> Nodes;
+	TArray<int32> FreeNodes;
+	int32 Root = INDEX_NONE;
+	int32 LeafCount = 0;
+
+	int32 AllocNode();
+	void  FreeNode(int32 Id);
+	void  InsertLeaf(int32 Leaf);
+	void  RemoveLeaf(int32 Leaf);
+
+	static float Area(const FBox& B)
+	{
+		const FVector E = B.GetSize();
+		return 2.f * float(E.X * E.Y + E.Y * E.Z + E.Z * E.X);
+	}
+};
+
+template<typename FVisit>
+void FTabletopAABBTree::QueryOverlap(const FBox& Box, FVisit&& Visit) const
+{
+	if (Root == INDEX_NONE) return;
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(Root);
+	while (Stack.Num())
+	{
+		const FNode& N = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (!N.Box.Intersect(Box)) continue;
+		if (N.IsLeaf()) { Visit(N.Payload); continue; }
+		Stack.Add(N.Left);
+		Stack.Add(N.Right);
+	}
+}
+
+template<typename FVisit>
+void FTabletopAABBTree::QuerySegment(const FVector& Start, const FVector& End, FVisit&& Visit) const
+{
+	if (Root == INDEX_NONE) return;
+	const FVector Dir = End - Start;
+	const bool bPoint = Dir.IsNearlyZero();
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(Root);
+	while (Stack.Num())
+	{
+		const FNode& N = Nodes[Stack.Pop(EAllowShrinking::No)];
+		const bool bHit = bPoint ? N.Box.IsInsideOrOn(Start) : FMath::LineBoxIntersection(N.Box, Start, End, Dir);
+		if (!bHit) continue;
+		if (N.IsLeaf()) { Visit(N.Payload); continue; }
+		Stack.Add(N.Left);
+		Stack.Add(N.Right);
+	}
+}
+
+template<typename FVisit>
+void FTabletopAABBTree::QueryNearest(const FVector& P, float MaxDistSq, FVisit&& Visit) const
+{
+	if (Root == INDEX_NONE) return;
+
+	struct FItem { float D2; int32 Node; };
+	auto Closer = [](const FItem& A, const FItem& B) { return A.D2 < B.D2; };
+
+	TArray<FItem, TInlineAllocator<64>> Heap;
+	Heap.HeapPush(FItem{ (float)Nodes[Root].Box.ComputeSquaredDistanceToPoint(P), Root }, Closer);
+
+	float Best = MaxDistSq;
+	while (Heap.Num())
+	{
+		FItem It;
+		Heap.HeapPop(It, Closer, EAllowShrinking::No);
+		if (It.D2 > Best) break; // everything left is farther
+
+		const FNode& N = Nodes[It.Node];
+		if (N.IsLeaf())
+		{
+			Best = FMath::Min(Best, Visit(N.Payload, It.D2));
+			continue;
+		}
+		for (const int32 Child : { N.Left, N.Right })
+		{
+			const float D2 = (float)Nodes[Child].Box.ComputeSquaredDistanceToPoint(P);
+			if (D2 <= Best) Heap.HeapPush(FItem{ D2, Child }, Closer);
+		}
+	}
+}
+
+/**
+ * Every ACoverVolume in the world, registered from BeginPlay/EndPlay, with its collision bounds in an AABB tree.
+ * Bounds refit whenever the volume re-applies its state (damage, presets); non-blocking volumes stay listed but leave the tree.
+ * If the map has a baked cover grid (CoverBake commandlet) it is loaded on world begin play and used to answer
+ * "provably clear / provably far" questions without touching physics, for as long as every live cover still fits its baked footprint.
+ */
+UCLASS()
+class TABLETOP_API UTabletopCoverRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UTabletopCoverRegistrySubsystem* Get(const UObject* WorldContext);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	void RegisterCover(ACoverVolume* Cover);
+	void UnregisterCover(ACoverVolume* Cover);
+	void UpdateCover(ACoverVolume* Cover);
+
+	void  GetAllCovers(TArray<ACoverVolume*>& Out) const;
+	int32 NumCovers() const { return Slots.Num(); }
+
+	/**
+	 * Closest point on any blocking cover's box collision within MaxDistCm (<= 0 = unbounded).
+	 * Only volumes whose bounds are in range reach GetClosestPointOnCollision. Returns the distance, or -1 if none.
+	 */
+	float FindNearestCover(const FVector& P, float MaxDistCm, ACoverVolume*& OutCover, FVector& OutPointOnSurface) const;
+
+	void QueryOverlap(const FBox& Box, TArray<ACoverVolume*>& Out) const;
+	void QuerySegment(const FVector& Start, const FVector& End, TArray<ACoverVolume*>& Out) const;
+
+	// Baked grid, only while it still describes the live covers (nullptr otherwise)
+	const UTabletopCoverBakeData* GetTrustedBake() const { return bBakeTrusted ? CoverBake.Get() : nullptr; }
+
+	// O(1) baked answers; false just means "don't know, trace it"
+	bool IsSegmentProvablyClear(const FVector& A, const FVector& B) const;
+	bool IsCoverProvablyBeyond(const FVector& P, float DistCm) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FSlot
+	{
+		TWeakObjectPtr<ACoverVolume> Cover;
+		int32 Proxy = INDEX_NONE; // INDEX_NONE while the volume blocks nothing
+	};
+
+	static bool BlockingBounds(const ACoverVolume* Cover, FBox& OutBox);
+	void CheckAgainstBake(const ACoverVolume* Cover, const FBox& Blocking);
+
+	TSparseArray<FSlot> Slots;
+	TMap<TObjectKey<ACoverVolume>, int32> SlotOf;
+	FTabletopAABBTree Tree;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTabletopCoverBakeData> CoverBake = nullptr;
+
+	TMap<FName, int32> BakedCoverByName;
+	bool bBakeTrusted = false;
+};
@@ -0,0 +1,125 @@
+#include "TabletopDebugDraw.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Tabletop/Gamemodes/MatchGameMode.h"
+
+bool FTabletopDebugPrim::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 K = Ar.IsSaving() ? FMath::Min<uint32>(Kind, 3) : 0;
+	Ar.SerializeBits(&K, 2);
+	if (Ar.IsLoading()) Kind = (uint8)K;
+
+	Ar << Color;
+	Ar << Duration;
+
+	bOutSuccess = true;
+	bool bOk = true;
+	switch ((ETabletopDebugPrimKind)Kind)
+	{
+	case ETabletopDebugPrimKind::Line:
+		Ar << Thickness;
+		A.NetSerialize(Ar, Map, bOk); bOutSuccess &= bOk;
+		B.NetSerialize(Ar, Map, bOk); bOutSuccess &= bOk;
+		break;
+	case ETabletopDebugPrimKind::Sphere:
+		Ar << Thickness;
+		Ar << Radius;
+		A.NetSerialize(Ar, Map, bOk); bOutSuccess &= bOk;
+		break;
+	case ETabletopDebugPrimKind::Text:
+		Ar << Thickness;
+		A.NetSerialize(Ar, Map, bOk); bOutSuccess &= bOk;
+		Ar << Text;
+		break;
+	case ETabletopDebugPrimKind::Screen:
+		Ar << Text;
+		break;
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return true;
+}
+
+#if TABLETOP_NET_DEBUG
+
+static TAutoConsoleVariable<int32> CVarDebugDrawCover(
+	TEXT("tabletop.DebugDraw.Cover"), 0,
+	TEXT("Send cover query rays and notes to all clients."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<int32> CVarDebugDrawMove(
+	TEXT("tabletop.DebugDraw.Move"), 0,
+	TEXT("Send move validation / clamp spheres and lines to all clients."),
+	ECVF_Cheat);
+
+bool FTabletopDebugDraw::IsEnabled(ETabletopDebugCategory Cat, bool bForce)
+{
+	if (bForce) return true;
+	switch (Cat)
+	{
+	case ETabletopDebugCategory::Cover: return CVarDebugDrawCover.GetValueOnGameThread() != 0;
+	case ETabletopDebugCategory::Move:  return CVarDebugDrawMove.GetValueOnGameThread() != 0;
+	}
+	return false;
+}
+
+static void QueuePrim(const UObject* WorldContext, FTabletopDebugPrim&& P, float Time)
+{
+	const UWorld* W = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	AMatchGameState* S = W ? W->GetGameState<AMatchGameState>() : nullptr;
+	if (!S || !S->HasAuthority()) return;
+
+	P.Duration = (uint8)FMath::Clamp(FMath::RoundToInt(Time * 10.f), 1, 255);
+	S->QueueDebugPrim(MoveTemp(P));
+}
+
+static uint8 QuantizeThickness(float Thickness)
+{
+	return (uint8)FMath::Clamp(FMath::RoundToInt(Thickness * 4.f), 1, 255);
+}
+
+void FTabletopDebugDraw::Line(const UObject* WorldContext, const FVector& Start, const FVector& End, FColor Color, float Time, float Thickness)
+{
+	FTabletopDebugPrim P;
+	P.Kind      = (uint8)ETabletopDebugPrimKind::Line;
+	P.Color     = Color;
+	P.Thickness = QuantizeThickness(Thickness);
+	P.A         = Start;
+	P.B         = End;
+	QueuePrim(WorldContext, MoveTemp(P), Time);
+}
+
+void FTabletopDebugDraw::Sphere(const UObject* WorldContext, const FVector& Center, float Radius, FColor Color, float Time, float Thickness)
+{
+	FTabletopDebugPrim P;
+	P.Kind      = (uint8)ETabletopDebugPrimKind::Sphere;
+	P.Color     = Color;
+	P.Thickness = QuantizeThickness(Thickness);
+	P.Radius    = (uint16)FMath::Clamp(FMath::RoundToInt(Radius), 1, 65535);
+	P.A         = Center;
+	QueuePrim(WorldContext, MoveTemp(P), Time);
+}
+
+void FTabletopDebugDraw::Text(const UObject* WorldContext, const FVector& WorldLoc, const FString& Text, FColor Color, float Time, float Scale)
+{
+	FTabletopDebugPrim P;
+	P.Kind      = (uint8)ETabletopDebugPrimKind::Text;
+	P.Color     = Color;
+	P.Thickness = (uint8)FMath::Clamp(FMath::RoundToInt(Scale * 10.f), 1, 255);
+	P.A         = WorldLoc;
+	P.Text      = Text;
+	QueuePrim(WorldContext, MoveTemp(P), Time);
+}
+
+void FTabletopDebugDraw::ScreenMsg(const UObject* WorldContext, const FString& Text, FColor Color, float Time)
+{
+	FTabletopDebugPrim P;
+	P.Kind  = (uint8)ETabletopDebugPrimKind::Screen;
+	P.Color = Color;
+	P.Text  = Text;
+	QueuePrim(WorldContext, MoveTemp(P), Time);
+}
+
+#endif // TABLETOP_NET_DEBUG
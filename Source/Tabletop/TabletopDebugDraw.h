@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "TabletopDebugDraw.generated.h"
+
+// Networked debug draws (cover rays, move checks). Player-facing messages stay on AMatchGameState's own multicasts.
+// 0 = every FTabletopDebugDraw call is an empty inline and IsEnabled() is constexpr false, so callers' message building goes too.
+#ifndef TABLETOP_NET_DEBUG
+	#define TABLETOP_NET_DEBUG !(UE_BUILD_SHIPPING)
+#endif
+
+// Each one has a console variable, off by default: tabletop.DebugDraw.Cover / .Move
+enum class ETabletopDebugCategory : uint8
+{
+	Cover,   // per-ray lines + notes from the cover query
+	Move,    // move validation / clamp spheres, lines and the [MoveCheck] screen line
+};
+
+enum class ETabletopDebugPrimKind : uint8
+{
+	Line,
+	Sphere,
+	Text,
+	Screen,
+};
+
+// One queued draw. Sent with its own NetSerialize: points are FVector_NetQuantize (whole cm),
+// duration in 0.1 s, thickness in 0.25 units, and only the fields the kind actually uses.
+USTRUCT()
+struct FTabletopDebugPrim
+{
+	GENERATED_BODY()
+
+	UPROPERTY() uint8  Kind      = 0;     // ETabletopDebugPrimKind
+	UPROPERTY() FColor Color     = FColor::White;
+	UPROPERTY() uint8  Duration  = 40;    // tenths of a second
+	UPROPERTY() uint8  Thickness = 8;     // quarter units; text: scale in tenths
+	UPROPERTY() uint16 Radius    = 0;     // spheres, cm
+	UPROPERTY() FVector_NetQuantize A;    // line start / sphere centre / text location
+	UPROPERTY() FVector_NetQuantize B;    // line end
+	UPROPERTY() FString Text;             // text + screen
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FTabletopDebugPrim> : public TStructOpsTypeTraitsBase2<FTabletopDebugPrim>
+{
+	enum { WithNetSerializer = true };
+};
+
+/**
+ * Server-side front for debug draws that every client should see.
+ * Calls queue into the match game state and go out once per frame as a single unreliable multicast
+ * (AMatchGameState::Multicast_DebugDrawBatch), so a shot with a dozen cover rays is one RPC, not thirty.
+ *
+ * The draw calls don't check the category themselves - wrap them in IsEnabled() so the strings
+ * and geometry aren't even built when the category is off.
+ */
+struct TABLETOP_API FTabletopDebugDraw
+{
+#if TABLETOP_NET_DEBUG
+	// bForce: per-actor opt-in kept from the old flags (GM bDebugCoverTraces, GS bDrawDebugHelpers)
+	static bool IsEnabled(ETabletopDebugCategory Cat, bool bForce = false);
+
+	static void Line(const UObject* WorldContext, const FVector& Start, const FVector& End, FColor Color, float Time = 5.f, float Thickness = 2.f);
+	static void Sphere(const UObject* WorldContext, const FVector& Center, float Radius, FColor Color, float Time = 5.f, float Thickness = 2.f);
+	static void Text(const UObject* WorldContext, const FVector& WorldLoc, const FString& Text, FColor Color = FColor::Black, float Time = 3.f, float Scale = 1.f);
+	static void ScreenMsg(const UObject* WorldContext, const FString& Text, FColor Color = FColor::Yellow, float Time = 3.f);
+#else
+	static constexpr bool IsEnabled(ETabletopDebugCategory, bool = false) { return false; }
+
+	static void Line(const UObject*, const FVector&, const FVector&, FColor, float = 5.f, float = 2.f) {}
+	static void Sphere(const UObject*, const FVector&, float, FColor, float = 5.f, float = 2.f) {}
+	static void Text(const UObject*, const FVector&, const FString&, FColor = FColor::Black, float = 3.f, float = 1.f) {}
+	static void ScreenMsg(const UObject*, const FString&, FColor = FColor::Yellow, float = 3.f) {}
+#endif
+};
@@ -0,0 +1,150 @@
+#include "TabletopDeploymentZoneSubsystem.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Tabletop/Actors/DeploymentZone.h"
+
+UTabletopDeploymentZoneSubsystem* UTabletopDeploymentZoneSubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UTabletopDeploymentZoneSubsystem>() : nullptr;
+}
+
+bool UTabletopDeploymentZoneSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTabletopDeploymentZoneSubsystem::Deinitialize()
+{
+	Zones.Reset();
+	BuiltFlags.Reset();
+	for (TArray<FZoneBounds>& L : TeamZones) L.Reset();
+	bDirty = true;
+	Super::Deinitialize();
+}
+
+void UTabletopDeploymentZoneSubsystem::RegisterZone(ADeploymentZone* Zone)
+{
+	if (!Zone) return;
+	Zones.AddUnique(Zone);
+	bDirty = true;
+}
+
+void UTabletopDeploymentZoneSubsystem::UnregisterZone(ADeploymentZone* Zone)
+{
+	Zones.RemoveAll([Zone](const TWeakObjectPtr<ADeploymentZone>& W) { return !W.IsValid() || W.Get() == Zone; });
+	bDirty = true;
+}
+
+// ---------------- cache ----------------
+
+bool UTabletopDeploymentZoneSubsystem::FZoneBounds::Contains(const FVector& P) const
+{
+	// Strict, like FBox::IsInside in ContainsLocation
+	const FVector D = P - Center;
+	if (FMath::Abs(FVector::DotProduct(D, Axis[0])) >= HalfExtent.X) return false;
+	if (FMath::Abs(FVector::DotProduct(D, Axis[1])) >= HalfExtent.Y) return false;
+	return b2D || FMath::Abs(FVector::DotProduct(D, Axis[2])) < HalfExtent.Z;
+}
+
+bool UTabletopDeploymentZoneSubsystem::ZoneFlagsChanged() const
+{
+	if (BuiltFlags.Num() != Zones.Num()) return true;
+	for (int32 i = 0; i < Zones.Num(); ++i)
+	{
+		const ADeploymentZone* Z = Zones[i].Get();
+		if (!Z) { if (BuiltFlags[i].bEnabled) return true; continue; } // gone; only matters if it was counted
+		if (BuiltFlags[i].Owner != (uint8)Z->CurrentOwner || BuiltFlags[i].bEnabled != Z->bEnabled) return true;
+	}
+	return false;
+}
+
+void UTabletopDeploymentZoneSubsystem::RebuildIfDirty() const
+{
+	// A handful of zones, so comparing flags per query is cheap; catches writes that never called NotifyZoneChanged
+	if (!bDirty && !ZoneFlagsChanged()) return;
+	bDirty = false;
+
+	for (TArray<FZoneBounds>& L : TeamZones) L.Reset();
+	BuiltFlags.Reset(Zones.Num());
+
+	for (const TWeakObjectPtr<ADeploymentZone>& W : Zones)
+	{
+		const ADeploymentZone* Z = W.Get();
+		FZoneFlags& Flags = BuiltFlags.AddDefaulted_GetRef();
+		if (Z)
+		{
+			Flags.Owner    = (uint8)Z->CurrentOwner;
+			Flags.bEnabled = Z->bEnabled;
+		}
+		if (!Z || !Z->bEnabled || !Z->Zone) continue;
+
+		const FTransform T = Z->Zone->GetComponentTransform();
+		FZoneBounds B;
+		B.Center     = T.GetLocation();
+		B.Axis[0]    = T.GetUnitAxis(EAxis::X);
+		B.Axis[1]    = T.GetUnitAxis(EAxis::Y);
+		B.Axis[2]    = T.GetUnitAxis(EAxis::Z);
+		B.HalfExtent = Z->Zone->GetUnscaledBoxExtent() * T.GetScale3D().GetAbs();
+		B.b2D        = Z->bUse2DCheck;
+
+		switch (Z->CurrentOwner)
+		{
+		case EDeployOwner::Team1: TeamZones[1].Add(B); break;
+		case EDeployOwner::Team2: TeamZones[2].Add(B); break;
+		default:
+			for (TArray<FZoneBounds>& L : TeamZones) L.Add(B);
+			break;
+		}
+	}
+}
+
+const TArray<UTabletopDeploymentZoneSubsystem::FZoneBounds>& UTabletopDeploymentZoneSubsystem::ZonesFor(int32 TeamNum) const
+{
+	RebuildIfDirty();
+	return TeamZones[(TeamNum == 1 || TeamNum == 2) ? TeamNum : 0];
+}
+
+int32 UTabletopDeploymentZoneSubsystem::NumZonesForTeam(int32 TeamNum) const
+{
+	return TeamNum > 0 ? ZonesFor(TeamNum).Num() : 0;
+}
+
+// ---------------- queries ----------------
+
+bool UTabletopDeploymentZoneSubsystem::IsLocationAllowedForTeam(int32 TeamNum, const FVector& WorldLocation) const
+{
+	if (TeamNum <= 0) return false;
+
+	for (const FZoneBounds& B : ZonesFor(TeamNum))
+	{
+		if (B.Contains(WorldLocation)) return true;
+	}
+	return false;
+}
+
+bool UTabletopDeploymentZoneSubsystem::AreLocationsAllowedForTeam(int32 TeamNum, TConstArrayView<FVector> Locations, TBitArray<>* OutAllowed) const
+{
+	if (OutAllowed) OutAllowed->Init(false, Locations.Num());
+	if (TeamNum <= 0) return Locations.Num() == 0;
+
+	TBitArray<> Done(false, Locations.Num());
+	int32 Remaining = Locations.Num();
+
+	// Zone-major: each zone's box is read once and tested against every point still outside
+	for (const FZoneBounds& B : ZonesFor(TeamNum))
+	{
+		for (int32 i = 0; i < Locations.Num(); ++i)
+		{
+			if (Done[i] || !B.Contains(Locations[i])) continue;
+			Done[i] = true;
+			--Remaining;
+		}
+		if (Remaining == 0) break;
+	}
+
+	if (OutAllowed) *OutAllowed = Done;
+	return Remaining == 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TabletopDeploymentZoneSubsystem.generated.h"
+
+class ADeploymentZone;
+
+/**
+ * Deployment zones flattened into per-team lists of oriented boxes.
+ * Zones register on BeginPlay / leave on EndPlay and mark the cache dirty when they move or their
+ * owner / enabled flag changes; queries then never recompute transforms. Owner / enabled are also
+ * rechecked against what the cache was built from, so a direct write that skipped the setters still lands.
+ */
+UCLASS()
+class TABLETOP_API UTabletopDeploymentZoneSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UTabletopDeploymentZoneSubsystem* Get(const UObject* WorldContext);
+
+	virtual void Deinitialize() override;
+
+	void RegisterZone(ADeploymentZone* Zone);
+	void UnregisterZone(ADeploymentZone* Zone);
+	void MarkDirty() { bDirty = true; }
+
+	// Same answer as ADeploymentZone::ContainsLocation over every enabled zone the team may use
+	bool IsLocationAllowedForTeam(int32 TeamNum, const FVector& WorldLocation) const;
+
+	// True only if every location is inside some usable zone; one pass over the zones for the whole set.
+	// OutAllowed (optional) gets a per-location result.
+	bool AreLocationsAllowedForTeam(int32 TeamNum, TConstArrayView<FVector> Locations, TBitArray<>* OutAllowed = nullptr) const;
+
+	int32 NumZonesForTeam(int32 TeamNum) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Box in world space: centre + unit axes + half extents (scale folded in)
+	struct FZoneBounds
+	{
+		FVector Center = FVector::ZeroVector;
+		FVector Axis[3] = { FVector::ForwardVector, FVector::RightVector, FVector::UpVector };
+		FVector HalfExtent = FVector::ZeroVector;
+		bool    b2D = true;   // ignore the Z axis (ADeploymentZone::bUse2DCheck)
+
+		bool Contains(const FVector& P) const;
+	};
+
+	void RebuildIfDirty() const;
+	const TArray<FZoneBounds>& ZonesFor(int32 TeamNum) const;
+
+	TArray<TWeakObjectPtr<ADeploymentZone>> Zones;
+
+	// Owner / enabled of each entry in Zones as of the last rebuild (same order)
+	struct FZoneFlags
+	{
+		uint8 Owner    = 0;
+		bool  bEnabled = false;
+	};
+	mutable TArray<FZoneFlags> BuiltFlags;
+	bool ZoneFlagsChanged() const;
+
+	// [0] = Either only (any team other than 1/2), [1] = Team1 + Either, [2] = Team2 + Either
+	mutable TArray<FZoneBounds> TeamZones[3];
+	mutable bool bDirty = true;
+};
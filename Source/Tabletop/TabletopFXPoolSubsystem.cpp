@@ -0,0 +1,128 @@
+#include "TabletopFXPoolSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+#include "Sound/SoundBase.h"
+
+UTabletopFXPoolSubsystem* UTabletopFXPoolSubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UTabletopFXPoolSubsystem>() : nullptr;
+}
+
+bool UTabletopFXPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTabletopFXPoolSubsystem::Deinitialize()
+{
+	Primed.Reset();
+	LiveSounds.Reset();
+	NumLiveSounds = 0;
+	Super::Deinitialize();
+}
+
+bool UTabletopFXPoolSubsystem::IsDedicated() const
+{
+	const UWorld* W = GetWorld();
+	return !W || W->GetNetMode() == NM_DedicatedServer;
+}
+
+// ---------------- niagara ----------------
+
+void UTabletopFXPoolSubsystem::Prewarm(UNiagaraSystem* System, int32 Count)
+{
+	if (!System || Count <= 0 || IsDedicated()) return;
+
+	Count = FMath::Min(Count, (int32)System->MaxPoolSize);
+	int32& Have = Primed.FindOrAdd(System);
+	if (Count <= Have) return;
+
+	// Spawn them all inactive first, then hand back; releasing one at a time would just recycle the same component
+	UWorld* W = GetWorld();
+	TArray<UNiagaraComponent*, TInlineAllocator<16>> Warm;
+	for (int32 i = Have; i < Count; ++i)
+	{
+		if (UNiagaraComponent* C = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+				W, System, FVector::ZeroVector, FRotator::ZeroRotator, FVector(1.f),
+				/*bAutoDestroy=*/false, /*bAutoActivate=*/false, ENCPoolMethod::ManualRelease, /*bPreCullCheck=*/false))
+		{
+			Warm.Add(C);
+		}
+	}
+	for (UNiagaraComponent* C : Warm)
+	{
+		C->ReleaseToPool();
+	}
+	Have = Count;
+}
+
+UNiagaraComponent* UTabletopFXPoolSubsystem::SpawnOneShot(UNiagaraSystem* System, const FVector& Loc, const FRotator& Rot)
+{
+	if (!System || IsDedicated()) return nullptr;
+
+	// AutoRelease: the pool takes it back when the system completes
+	return UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+		GetWorld(), System, Loc, Rot, FVector(1.f),
+		/*bAutoDestroy=*/true, /*bAutoActivate=*/true, ENCPoolMethod::AutoRelease, /*bPreCullCheck=*/true);
+}
+
+// ---------------- audio ----------------
+
+void UTabletopFXPoolSubsystem::PruneSounds(double Now)
+{
+	for (auto It = LiveSounds.CreateIterator(); It; ++It)
+	{
+		FSoundEnds& Ends = It.Value();
+		const int32 Before = Ends.Num();
+		Ends.RemoveAllSwap([Now](double End) { return End <= Now; });
+		NumLiveSounds -= Before - Ends.Num();
+		if (Ends.Num() == 0) It.RemoveCurrent();
+	}
+}
+
+bool UTabletopFXPoolSubsystem::PlayOneShotSound(USoundBase* Sound, const FVector& Loc, USoundAttenuation* Attenuation, USoundConcurrency* Concurrency)
+{
+	if (!Sound || IsDedicated()) return false;
+
+	UWorld* W = GetWorld();
+	const double Now = W->GetAudioTimeSeconds();
+	PruneSounds(Now);
+
+	if (NumLiveSounds >= MaxOneShotSounds) return false;
+	FSoundEnds& Ends = LiveSounds.FindOrAdd(Sound);
+	if (Ends.Num() >= MaxOneShotsPerSound) return false;
+
+	UGameplayStatics::PlaySoundAtLocation(W, Sound, Loc, 1.f, 1.f, 0.f, Attenuation, Concurrency);
+
+	const float Dur = FMath::Clamp(Sound->GetDuration(), 0.05f, MaxTrackedSoundSec);
+	Ends.Add(Now + Dur);
+	++NumLiveSounds;
+	return true;
+}
+
+// ---------------- volleys ----------------
+
+void UTabletopFXPoolSubsystem::PickRepresentatives(int32 Num, int32 AggregateAbove, int32 Keep, TArray<int32>& Out)
+{
+	Out.Reset();
+	if (Num <= 0) return;
+
+	if (AggregateAbove <= 0 || Num <= AggregateAbove)
+	{
+		for (int32 i = 0; i < Num; ++i) Out.Add(i);
+		return;
+	}
+
+	// Even stride so the subset still spans the whole squad frontage
+	Keep = FMath::Clamp(Keep, 1, Num);
+	for (int32 k = 0; k < Keep; ++k)
+	{
+		Out.Add((k * Num) / Keep);
+	}
+}
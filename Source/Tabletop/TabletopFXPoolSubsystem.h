@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TabletopFXPoolSubsystem.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+class USoundBase;
+class USoundAttenuation;
+class USoundConcurrency;
+
+/**
+ * Per-world front for weapon one-shots.
+ * Niagara goes through the engine component pool (ENCPoolMethod::AutoRelease) which we prime per asset
+ * when a unit picks up its FX from the FUnitRow, so a volley reuses warm components instead of spawning.
+ * One-shot sounds are capped per asset and overall; anything past the cap is simply not played.
+ * Nothing is spawned on a dedicated server.
+ */
+UCLASS()
+class TABLETOP_API UTabletopFXPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UTabletopFXPoolSubsystem* Get(const UObject* WorldContext);
+
+	virtual void Deinitialize() override;
+
+	// Make sure at least Count pooled components of System exist (clamped to the asset's MaxPoolSize)
+	void Prewarm(UNiagaraSystem* System, int32 Count);
+
+	UNiagaraComponent* SpawnOneShot(UNiagaraSystem* System, const FVector& Loc, const FRotator& Rot);
+
+	// false if the sound was dropped by the caps
+	bool PlayOneShotSound(USoundBase* Sound, const FVector& Loc, USoundAttenuation* Attenuation = nullptr, USoundConcurrency* Concurrency = nullptr);
+
+	// Which of Num models/sites to actually render. Above AggregateAbove (0 = never) keeps Keep of them, evenly spread.
+	static void PickRepresentatives(int32 Num, int32 AggregateAbove, int32 Keep, TArray<int32>& Out);
+
+	int32 MaxOneShotSounds     = 12; // across all assets
+	int32 MaxOneShotsPerSound  = 4;
+	float MaxTrackedSoundSec   = 3.f; // looping / very long one-shots count as this long
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	bool IsDedicated() const;
+	void PruneSounds(double Now);
+
+	TMap<TObjectKey<UNiagaraSystem>, int32> Primed;
+
+	using FSoundEnds = TArray<double, TInlineAllocator<8>>;
+	TMap<TObjectKey<USoundBase>, FSoundEnds> LiveSounds; // end times of one-shots still playing
+	int32 NumLiveSounds = 0;
+};
@@ -0,0 +1,35 @@
+#include "TabletopPushModel.h"
+
+#include "GameFramework/Actor.h"
+#include "Net/UnrealNetwork.h"
+
+DEFINE_STAT(STAT_TabletopRegisteredRepProps);
+DEFINE_STAT(STAT_TabletopRegisteredNonPushProps);
+DEFINE_STAT(STAT_TabletopPushDirtyMarks);
+
+void TabletopPushModel::TrackActor(const AActor* Actor, bool bAdd)
+{
+#if STATS
+	if (!Actor || !Actor->GetIsReplicated() || !Actor->HasAuthority() || Actor->GetNetMode() == NM_Standalone) return;
+
+	TArray<FLifetimeProperty> Props;
+	Actor->GetLifetimeReplicatedProps(Props);
+
+	uint32 NonPush = 0;
+	for (const FLifetimeProperty& P : Props)
+	{
+		if (!P.bIsPushBased) ++NonPush;
+	}
+
+	if (bAdd)
+	{
+		INC_DWORD_STAT_BY(STAT_TabletopRegisteredRepProps, Props.Num());
+		INC_DWORD_STAT_BY(STAT_TabletopRegisteredNonPushProps, NonPush);
+	}
+	else
+	{
+		DEC_DWORD_STAT_BY(STAT_TabletopRegisteredRepProps, Props.Num());
+		DEC_DWORD_STAT_BY(STAT_TabletopRegisteredNonPushProps, NonPush);
+	}
+#endif
+}
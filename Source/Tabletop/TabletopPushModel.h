@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Stats/Stats.h"
+
+/**
+ * Push-model replication for the gameplay actors (units, covers, objectives, match state).
+ * With net.IsPushModelEnabled the server only compares push-based properties that were marked dirty,
+ * so every server-side write to one must go through TABLETOP_MARK_DIRTY or a class helper that uses it.
+ *
+ * stat TabletopNet (none of these count actual comparisons, they're the inputs to that):
+ *   "Registered rep props"      - replicated props on live tracked actors; each net update of an actor walks all of its own without push model
+ *   "Registered non-push props" - the part of those push model still has to compare every net update
+ *   "Push dirty marks"          - TABLETOP_MARK_DIRTY calls this frame; repeated marks of one prop before a net update only cost one compare
+ */
+DECLARE_STATS_GROUP(TEXT("TabletopNet"), STATGROUP_TabletopNet, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Registered rep props"),      STAT_TabletopRegisteredRepProps,     STATGROUP_TabletopNet, TABLETOP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Registered non-push props"), STAT_TabletopRegisteredNonPushProps, STATGROUP_TabletopNet, TABLETOP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Push dirty marks"),              STAT_TabletopPushDirtyMarks,         STATGROUP_TabletopNet, TABLETOP_API);
+
+#define TABLETOP_MARK_DIRTY(ClassName, PropertyName, Object) \
+	do { MARK_PROPERTY_DIRTY_FROM_NAME(ClassName, PropertyName, Object); INC_DWORD_STAT(STAT_TabletopPushDirtyMarks); } while (0)
+
+namespace TabletopPushModel
+{
+	// Server only: add (BeginPlay) / remove (EndPlay) the actor's registered property counts in the stats above
+	TABLETOP_API void TrackActor(const AActor* Actor, bool bAdd);
+}
@@ -0,0 +1,280 @@
+#include "TabletopSpatialIndexSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Tabletop/Actors/UnitBase.h"
+#include "Tabletop/Gamemodes/MatchGameMode.h"
+
+UTabletopSpatialIndexSubsystem* UTabletopSpatialIndexSubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UTabletopSpatialIndexSubsystem>() : nullptr;
+}
+
+bool UTabletopSpatialIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTabletopSpatialIndexSubsystem::Deinitialize()
+{
+	Entries.Reset();
+	Cells.Reset();
+	Super::Deinitialize();
+}
+
+// ---------------- maintenance ----------------
+
+FIntPoint UTabletopSpatialIndexSubsystem::CellOf(const FVector& P) const
+{
+	return FIntPoint(FMath::FloorToInt(P.X / CellSizeCm), FMath::FloorToInt(P.Y / CellSizeCm));
+}
+
+void UTabletopSpatialIndexSubsystem::SyncCellSize()
+{
+	// Scale is replicated; clients can get it after the first units are in
+	const AMatchGameState* GS = GetWorld() ? GetWorld()->GetGameState<AMatchGameState>() : nullptr;
+	const float Wanted = CellInches * (GS ? GS->CmPerTTInchRep : 50.8f);
+	if (Wanted <= KINDA_SMALL_NUMBER || FMath::IsNearlyEqual(Wanted, CellSizeCm, 0.01f)) return;
+
+	CellSizeCm = Wanted;
+	Cells.Reset();
+	bHasOccupied = false;
+	for (TPair<TObjectKey<AUnitBase>, FIndexedUnit>& KV : Entries)
+	{
+		KV.Value.Cell = CellOf(KV.Value.Location);
+		AddToCell(KV.Value.Cell, KV.Key);
+	}
+}
+
+void UTabletopSpatialIndexSubsystem::AddToCell(const FIntPoint& Cell, TObjectKey<AUnitBase> Key)
+{
+	Cells.FindOrAdd(Cell).Add(Key);
+
+	if (!bHasOccupied)
+	{
+		Occupied = FIntRect(Cell, Cell);
+		bHasOccupied = true;
+	}
+	else
+	{
+		Occupied.Include(Cell);
+	}
+}
+
+void UTabletopSpatialIndexSubsystem::RemoveFromCell(const FIntPoint& Cell, TObjectKey<AUnitBase> Key)
+{
+	if (FCellBucket* Bucket = Cells.Find(Cell))
+	{
+		Bucket->RemoveSingleSwap(Key);
+		if (Bucket->Num() == 0) Cells.Remove(Cell);
+	}
+}
+
+void UTabletopSpatialIndexSubsystem::Capture(FIndexedUnit& E, const AUnitBase* U) const
+{
+	E.Location = U->GetActorLocation();
+	E.Models.Reset();
+	E.ModelReach = 0.f;
+	for (int32 i = 0; i < U->GetNumModelVisuals(); ++i)
+	{
+		const FVector L = U->GetModelWorldTransform(i).GetLocation();
+		E.Models.Add(L);
+		E.ModelReach = FMath::Max(E.ModelReach, FVector::Dist2D(L, E.Location));
+	}
+}
+
+void UTabletopSpatialIndexSubsystem::RegisterUnit(AUnitBase* U)
+{
+	if (!U) return;
+	SyncCellSize();
+
+	const TObjectKey<AUnitBase> Key(U);
+	if (Entries.Contains(Key))
+	{
+		UpdateUnit(U);
+		return;
+	}
+
+	FIndexedUnit& E = Entries.Add(Key);
+	E.Unit = U;
+	Capture(E, U);
+	E.Cell = CellOf(E.Location);
+	MaxModelReach = FMath::Max(MaxModelReach, E.ModelReach);
+	AddToCell(E.Cell, Key);
+}
+
+void UTabletopSpatialIndexSubsystem::UnregisterUnit(AUnitBase* U)
+{
+	const TObjectKey<AUnitBase> Key(U);
+	FIndexedUnit E;
+	if (Entries.RemoveAndCopyValue(Key, E))
+	{
+		RemoveFromCell(E.Cell, Key);
+	}
+}
+
+void UTabletopSpatialIndexSubsystem::UpdateUnit(AUnitBase* U)
+{
+	if (!U) return;
+
+	const TObjectKey<AUnitBase> Key(U);
+	FIndexedUnit* E = Entries.Find(Key);
+	if (!E)
+	{
+		// Transform bumps can land before BeginPlay registers (spawn/formation setup); catch up here
+		if (U->HasActorBegunPlay()) RegisterUnit(U);
+		return;
+	}
+
+	SyncCellSize();
+	Capture(*E, U);
+	MaxModelReach = FMath::Max(MaxModelReach, E->ModelReach);
+
+	const FIntPoint NewCell = CellOf(E->Location);
+	if (NewCell != E->Cell)
+	{
+		RemoveFromCell(E->Cell, Key);
+		E->Cell = NewCell;
+		AddToCell(NewCell, Key);
+	}
+}
+
+// ---------------- queries ----------------
+
+AUnitBase* UTabletopSpatialIndexSubsystem::Accept(const FIndexedUnit& E, const FUnitSpatialFilter& F) const
+{
+	AUnitBase* U = E.Unit.Get();
+	if (!U || U == F.Exclude) return nullptr;
+	if (F.bAliveOnly && U->ModelsCurrent <= 0) return nullptr;
+	if (F.Team && U->OwningPS != F.Team) return nullptr;
+	if (F.EnemiesOf && !F.EnemiesOf->IsEnemy(U)) return nullptr;
+	return U;
+}
+
+float UTabletopSpatialIndexSubsystem::DistSq(const FIndexedUnit& E, const FVector& Center, bool bAnyModel) const
+{
+	float Best = FVector::DistSquared(Center, E.Location);
+	if (bAnyModel)
+	{
+		for (const FVector& M : E.Models) Best = FMath::Min(Best, (float)FVector::DistSquared(Center, M));
+	}
+	return Best;
+}
+
+void UTabletopSpatialIndexSubsystem::QueryRadius(const FVector& Center, float RadiusCm, const FUnitSpatialFilter& Filter, TArray<AUnitBase*>& Out) const
+{
+	Out.Reset();
+	if (RadiusCm < 0.f || Entries.Num() == 0) return;
+
+	const float Pad = RadiusCm + (Filter.bAnyModel ? MaxModelReach : 0.f);
+	const FIntPoint Lo = CellOf(Center - FVector(Pad, Pad, 0.f));
+	const FIntPoint Hi = CellOf(Center + FVector(Pad, Pad, 0.f));
+	const float R2 = RadiusCm * RadiusCm;
+
+	for (int32 y = Lo.Y; y <= Hi.Y; ++y)
+	{
+		for (int32 x = Lo.X; x <= Hi.X; ++x)
+		{
+			const FCellBucket* Bucket = Cells.Find(FIntPoint(x, y));
+			if (!Bucket) continue;
+
+			for (const TObjectKey<AUnitBase>& Key : *Bucket)
+			{
+				const FIndexedUnit* E = Entries.Find(Key);
+				if (!E) continue;
+				AUnitBase* U = Accept(*E, Filter);
+				if (U && DistSq(*E, Center, Filter.bAnyModel) <= R2) Out.Add(U);
+			}
+		}
+	}
+}
+
+void UTabletopSpatialIndexSubsystem::QueryKNearest(const FVector& Center, int32 K, float MaxRadiusCm, const FUnitSpatialFilter& Filter, TArray<AUnitBase*>& Out) const
+{
+	Out.Reset();
+	if (K <= 0 || Entries.Num() == 0 || !bHasOccupied) return;
+
+	const float MaxR2 = (MaxRadiusCm > 0.f) ? MaxRadiusCm * MaxRadiusCm : TNumericLimits<float>::Max();
+
+	struct FCand { AUnitBase* Unit; float D2; };
+	TArray<FCand, TInlineAllocator<16>> Best; // sorted ascending, at most K
+
+	const FIntPoint C = CellOf(Center);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(Occupied.Min.X - C.X), FMath::Abs(Occupied.Max.X - C.X)),
+		FMath::Max(FMath::Abs(Occupied.Min.Y - C.Y), FMath::Abs(Occupied.Max.Y - C.Y)));
+
+	auto Visit = [&](int32 x, int32 y)
+	{
+		const FCellBucket* Bucket = Cells.Find(FIntPoint(x, y));
+		if (!Bucket) return;
+		for (const TObjectKey<AUnitBase>& Key : *Bucket)
+		{
+			const FIndexedUnit* E = Entries.Find(Key);
+			if (!E) continue;
+			AUnitBase* U = Accept(*E, Filter);
+			if (!U) continue;
+
+			const float D2 = DistSq(*E, Center, Filter.bAnyModel);
+			if (D2 > MaxR2) continue;
+			if (Best.Num() == K && D2 >= Best.Last().D2) continue;
+
+			int32 At = Best.Num();
+			while (At > 0 && Best[At - 1].D2 > D2) --At;
+			Best.Insert(FCand{ U, D2 }, At);
+			if (Best.Num() > K) Best.Pop();
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// Nothing in this ring can be closer than (Ring-1) cells (less any-model reach)
+		const float RingMin = FMath::Max(0.f, (Ring - 1) * CellSizeCm - (Filter.bAnyModel ? MaxModelReach : 0.f));
+		const float RingMin2 = RingMin * RingMin;
+		if (RingMin2 > MaxR2) break;
+		if (Best.Num() == K && RingMin2 > Best.Last().D2) break;
+
+		if (Ring == 0) { Visit(C.X, C.Y); continue; }
+		for (int32 i = -Ring; i <= Ring; ++i)
+		{
+			Visit(C.X + i, C.Y - Ring);
+			Visit(C.X + i, C.Y + Ring);
+		}
+		for (int32 i = -Ring + 1; i <= Ring - 1; ++i)
+		{
+			Visit(C.X - Ring, C.Y + i);
+			Visit(C.X + Ring, C.Y + i);
+		}
+	}
+
+	Out.Reserve(Best.Num());
+	for (const FCand& B : Best) Out.Add(B.Unit);
+}
+
+AUnitBase* UTabletopSpatialIndexSubsystem::FindNearest(const FVector& Center, float MaxRadiusCm, const FUnitSpatialFilter& Filter) const
+{
+	TArray<AUnitBase*> One;
+	QueryKNearest(Center, 1, MaxRadiusCm, Filter, One);
+	return One.Num() ? One[0] : nullptr;
+}
+
+void UTabletopSpatialIndexSubsystem::GetTeamUnits(const APlayerState* Team, TArray<AUnitBase*>& Out, bool bAliveOnly) const
+{
+	Out.Reset();
+	FUnitSpatialFilter F;
+	F.Team = Team;
+	F.bAliveOnly = bAliveOnly;
+	for (const TPair<TObjectKey<AUnitBase>, FIndexedUnit>& KV : Entries)
+	{
+		if (AUnitBase* U = Accept(KV.Value, F)) Out.Add(U);
+	}
+}
+
+bool UTabletopSpatialIndexSubsystem::GetModelReach(const AUnitBase* U, float& OutReachCm) const
+{
+	const FIndexedUnit* E = U ? Entries.Find(TObjectKey<AUnitBase>(U)) : nullptr;
+	if (!E) return false;
+	OutReachCm = E->ModelReach;
+	return true;
+}
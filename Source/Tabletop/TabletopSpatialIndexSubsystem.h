@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TabletopSpatialIndexSubsystem.generated.h"
+
+class AUnitBase;
+class APlayerState;
+
+// Which units a spatial query hands back
+struct FUnitSpatialFilter
+{
+	const APlayerState* Team      = nullptr; // only this team's units
+	const AUnitBase*    EnemiesOf = nullptr; // only units this one considers enemies (AUnitBase::IsEnemy)
+	const AUnitBase*    Exclude   = nullptr;
+	bool bAliveOnly = true;
+	bool bAnyModel  = false;                 // radius tests pass if any model is inside, not just the unit centre
+};
+
+/**
+ * Uniform 2D grid of units (plus their model positions), cell size in tabletop inches.
+ * Units register on BeginPlay, leave on EndPlay, and re-bucket whenever their transform version bumps
+ * (move, facing snap, formation rebuild, replicated movement on clients).
+ */
+UCLASS()
+class TABLETOP_API UTabletopSpatialIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UTabletopSpatialIndexSubsystem* Get(const UObject* WorldContext);
+
+	virtual void Deinitialize() override;
+
+	void RegisterUnit(AUnitBase* U);
+	void UnregisterUnit(AUnitBase* U);
+	void UpdateUnit(AUnitBase* U);
+
+	// Units within RadiusCm of Center (3D distance, same as the old actor-iterator checks)
+	void QueryRadius(const FVector& Center, float RadiusCm, const FUnitSpatialFilter& Filter, TArray<AUnitBase*>& Out) const;
+
+	// Up to K closest units, nearest first; MaxRadiusCm <= 0 = unbounded
+	void QueryKNearest(const FVector& Center, int32 K, float MaxRadiusCm, const FUnitSpatialFilter& Filter, TArray<AUnitBase*>& Out) const;
+
+	AUnitBase* FindNearest(const FVector& Center, float MaxRadiusCm, const FUnitSpatialFilter& Filter) const;
+
+	void GetTeamUnits(const APlayerState* Team, TArray<AUnitBase*>& Out, bool bAliveOnly = true) const;
+
+	// Farthest model from the unit's centre (2D) as of its last re-bucket; false if the unit isn't indexed yet
+	bool GetModelReach(const AUnitBase* U, float& OutReachCm) const;
+
+	int32 NumUnits() const { return Entries.Num(); }
+	float GetCellSizeCm() const { return CellSizeCm; }
+
+	// ~One 6" move per cell keeps most radius queries to a 3x3 block
+	static constexpr float CellInches = 6.f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FIndexedUnit
+	{
+		TWeakObjectPtr<AUnitBase> Unit;
+		FVector   Location   = FVector::ZeroVector;
+		float     ModelReach = 0.f; // farthest model from Location; widens the cell range for any-model tests
+		TArray<FVector, TInlineAllocator<10>> Models;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+	};
+
+	using FCellBucket = TArray<TObjectKey<AUnitBase>, TInlineAllocator<4>>;
+
+	FIntPoint CellOf(const FVector& P) const;
+	void SyncCellSize();
+	void AddToCell(const FIntPoint& Cell, TObjectKey<AUnitBase> Key);
+	void RemoveFromCell(const FIntPoint& Cell, TObjectKey<AUnitBase> Key);
+	void Capture(FIndexedUnit& E, const AUnitBase* U) const;
+	AUnitBase* Accept(const FIndexedUnit& E, const FUnitSpatialFilter& F) const;
+	float DistSq(const FIndexedUnit& E, const FVector& Center, bool bAnyModel) const;
+
+	TMap<TObjectKey<AUnitBase>, FIndexedUnit> Entries;
+	TMap<FIntPoint, FCellBucket> Cells;
+
+	float CellSizeCm    = CellInches * 50.8f;
+	float MaxModelReach = 0.f; // only grows between rebuckets; a loose bound is fine
+	FIntRect Occupied;         // cell bounds ever used; bounds the k-nearest ring walk
+	bool  bHasOccupied  = false;
+};
@@ -1,7 +1,9 @@
 #include "TurnContextWidget.h"
 
 #include "ActionButtonWidget.h"
+#include "CombatDistribution.h"
 #include "KeywordChipWidget.h"
+#include "KeywordProcessor.h"
 #include "LibraryHelpers.h"
 #include "UnitActionResourceComponent.h"
 #include "WeaponDisplayText.h"
@@ -493,6 +495,91 @@ void UTurnContextWidget::ClearEstimateFields()
     if (SaveFailText)    SaveFailText->SetText(FText::GetEmpty());
     if (EstDamageText)   EstDamageText->SetText(FText::GetEmpty());
     if (CoverStatusText) CoverStatusText->SetText(FText::GetEmpty());
+    if (KillChanceText)  KillChanceText->SetText(FText::GetEmpty());
+
+    EstDamageHistogram.Reset();
+    EstModelsKilledHistogram.Reset();
+    EstAttacker.Reset();
+    EstTarget.Reset();
+}
+
+// Mirrors the server's ResolveRangedAttack_Internal numbers (same keyword plan + replicated unit mods + cover).
+static FCombatEstimateInput BuildEstimateInput(const AUnitBase* Attacker, const AUnitBase* Target,
+                                               int32 HitMod, int32 SaveMod, float CmPerTT)
+{
+    auto StageMods = [&](ECombatEvent Stage)
+    {
+        FRollModifiers M = Attacker->CollectStageMods(Stage, /*bAsAttacker*/true, Target);
+        M.Accumulate(Target->CollectStageMods(Stage, /*bAsAttacker*/false, Attacker));
+        return M;
+    };
+
+    FAttackPlanSetup Setup;
+    Setup.AttackerModels    = FMath::Max(0, Attacker->ModelsCurrent);
+    Setup.TargetModels      = FMath::Max(0, Target->ModelsCurrent);
+    Setup.TargetToughness   = Target->GetToughness();
+    Setup.RangeInches       = FVector::Dist(Attacker->GetActorLocation(), Target->GetActorLocation()) / FMath::Max(1.f, CmPerTT);
+    Setup.bAttackerMoved    = Attacker->bMovedThisTurn;
+    Setup.bAttackerAdvanced = Attacker->bAdvancedThisTurn;
+    const FAttackPlan Plan = FAttackPlan::Build(Attacker->GetActiveWeaponProfile(), Attacker->GetCompiledKeywords(), Setup);
+
+    FCombatEstimateInput In;
+    In.Attacks   = Plan.Attacks;
+    In.HitNeed   = Plan.HitNeed;
+    In.WoundNeed = Plan.WoundNeed;
+    In.Damage    = Plan.Damage;
+    int32 AP     = Plan.AP;
+
+    // ---- PreHitCalc ---- (no dice: the Blast D3/D6 goes into the distribution instead)
+    FRollModifiers M = StageMods(ECombatEvent::PreHitCalc);
+    Plan.FoldStage(ECombatEvent::PreHitCalc, M, /*Dice*/nullptr);
+    In.ExtraAttackDie = Plan.SumOf(EAttackPlanOp::ExtraAttackDie);
+    In.bAutoHit = M.bAutoHit;
+    In.Attacks  = FMath::Max(0, In.Attacks + M.AttacksDelta);
+    In.HitNeed  = FMath::Clamp(In.HitNeed + M.HitNeedOffset, 2, 6);
+    In.HitNeed  = FMath::Clamp(In.HitNeed + (HitMod * -1), 2, 6);
+
+    In.SustainedHits      = Plan.SumOf(EAttackPlanOp::SustainedHits);
+    In.bLethalHits        = Plan.HasOp(EAttackPlanOp::LethalHits);
+    In.bDevastatingWounds = Plan.HasOp(EAttackPlanOp::DevastatingWounds);
+
+    // ---- PreWoundCalc ----
+    M = StageMods(ECombatEvent::PreWoundCalc);
+    Plan.FoldStage(ECombatEvent::PreWoundCalc, M, nullptr);
+    In.WoundNeed         = FMath::Clamp(In.WoundNeed + M.WoundNeedOffset, 2, 6);
+    In.bRerollAllWounds  = M.bRerollAllWounds;
+    In.bRerollOnesWounds = M.bRerollOnesWounds;
+
+    // ---- PreSavingThrows ----
+    M = StageMods(ECombatEvent::PreSavingThrows);
+    Plan.FoldStage(ECombatEvent::PreSavingThrows, M, nullptr);
+    const bool bIgnoreCover = M.bIgnoreCover;
+    AP        += M.APDelta;
+    In.Damage += M.DamageDelta; // same as the server: Max(1, weapon damage) + delta, no second clamp
+
+    int32 ArmourNeed = CombatMath::ModifiedSaveNeed(Target->GetSave(), AP);
+    ArmourNeed = FMath::Clamp(ArmourNeed - (bIgnoreCover ? 0 : SaveMod), 2, 7);
+    const int32 InvTN = FMath::Clamp(GetInvuln_Client(Target) + M.InvulnNeedOffset, 2, 7);
+    In.SaveNeed = (InvTN <= 6) ? FMath::Min(ArmourNeed, InvTN) : ArmourNeed;
+
+    // ---- PostDamageCompute ----
+    M = StageMods(ECombatEvent::PostDamageCompute);
+    Plan.FoldStage(ECombatEvent::PostDamageCompute, M, nullptr);
+    In.FnpNeed = FMath::Clamp(GetFeelNoPain_Client(Target) + M.FnpNeedOffset, 2, 7);
+
+    In.WoundsPerModel = Target->GetWoundsPerModel();
+    In.TargetModels   = FMath::Max(0, Target->ModelsCurrent);
+    In.TargetPool     = FMath::Max(0, Target->WoundsPool);
+    In.DamageCap      = In.TargetModels * In.WoundsPerModel; // server clamps by visible models; assume all
+    return In;
+}
+
+void UTurnContextWidget::HandleCombatEstimateReady()
+{
+    if (EstAttacker.IsValid() && EstTarget.IsValid())
+    {
+        UpdateCombatEstimates(EstAttacker.Get(), EstTarget.Get(), EstHitMod, EstSaveMod, EstCover);
+    }
 }
 
 void UTurnContextWidget::UpdateCombatEstimates(AUnitBase* Attacker, AUnitBase* Target,
@@ -500,65 +587,47 @@ void UTurnContextWidget::UpdateCombatEstimates(AUnitBase* Attacker, AUnitBase* T
 {
     if (!Attacker || !Target) { ClearEstimateFields(); return; }
 
-    const int32 models    = FMath::Max(0, Attacker->ModelsCurrent);
-    const int32 atkPM     = FMath::Max(0, Attacker->GetAttacks());
-    const int32 totalAtk  = models * atkPM;
+    EstAttacker = Attacker;
+    EstTarget   = Target;
+    EstHitMod   = HitMod;
+    EstSaveMod  = SaveMod;
+    EstCover    = CoverType;
 
-    const int32 dmg       = FMath::Max(1, Attacker->GetDamage());
-    const int32 sVal      = Attacker->WeaponStrengthRep;
-    const int32 tVal      = Target->GetToughness();
-    const int32 ap        = FMath::Max(0, Attacker->WeaponAPRep);
-    const int32 baseToHit = FMath::Clamp(Attacker->WeaponSkillToHitRep, 2, 6);
-    const int32 baseSave  = Target->GetSave();
-
-    const int32 hitNeed   = FMath::Clamp(baseToHit + (HitMod * -1), 2, 6);
-    const int32 woundNeed = CombatMath::ToWoundTarget(sVal, tVal);
-
-    int32 saveNeed = CombatMath::ModifiedSaveNeed(baseSave, ap);
-    saveNeed       = FMath::Clamp(saveNeed - SaveMod, 2, 7);
+    const AMatchGameState* S = GS();
+    const FCombatEstimateInput In = BuildEstimateInput(Attacker, Target, HitMod, SaveMod,
+                                                       S ? S->CmPerTTInchRep : 50.8f);
 
     const int32 invTN = GetInvuln_Client(Target);
-    if (invTN >= 2 && invTN <= 6)
-        saveNeed = FMath::Min(saveNeed, invTN);
+    const int32 fnpTN = In.FnpNeed;
 
-    const float pHit   = CombatMath::ProbAtLeast(hitNeed);
-    const float pWound = CombatMath::ProbAtLeast(woundNeed);
-    const float pSave  = (saveNeed <= 6) ? CombatMath::ProbAtLeast(saveNeed) : 0.f;
-    const float pFail  = 1.f - pSave;
-
-    const float pUnsavedPerAtk = pHit * pWound * pFail;
-    float evDamage             = float(totalAtk) * pUnsavedPerAtk * float(dmg);
-
-    const int32 fnpTN = GetFeelNoPain_Client(Target);
-    if (fnpTN >= 2 && fnpTN <= 6)
-    {
-        const float pFNP = CombatMath::ProbAtLeast(fnpTN);
-        evDamage *= (1.f - pFNP);
-    }
+    const float pHit   = In.bAutoHit ? 1.f : (float)FCombatDistribution::ProbAtLeast(In.HitNeed);
+    const float pWound = (float)FCombatDistribution::ProbAtLeast(In.WoundNeed, In.bRerollAllWounds, In.bRerollOnesWounds);
+    const float pFail  = 1.f - (float)FCombatDistribution::ProbAtLeast(In.SaveNeed);
 
     if (HitChanceText)
-        HitChanceText->SetText(FText::FromString(
-            FString::Printf(TEXT("Hit: %d%% (need %d+)"), FMath::RoundToInt(pHit*100.f), hitNeed)));
+        HitChanceText->SetText(FText::FromString(In.bAutoHit
+            ? FString(TEXT("Hit: 100% (auto)"))
+            : FString::Printf(TEXT("Hit: %d%% (need %d+)"), FMath::RoundToInt(pHit*100.f), In.HitNeed)));
 
     if (WoundChanceText)
         WoundChanceText->SetText(FText::FromString(
-            FString::Printf(TEXT("Wound: %d%% (need %d+)"), FMath::RoundToInt(pWound*100.f), woundNeed)));
+            FString::Printf(TEXT("Wound: %d%% (need %d+)"), FMath::RoundToInt(pWound*100.f), In.WoundNeed)));
 
     if (SaveFailText)
     {
-        if (saveNeed <= 6)
+        if (In.SaveNeed <= 6)
         {
-            if (invTN >= 2 && invTN <= 6 && saveNeed == invTN)
+            if (invTN >= 2 && invTN <= 6 && In.SaveNeed == invTN)
             {
                 SaveFailText->SetText(FText::FromString(
                     FString::Printf(TEXT("Fail Save: %d%% (save %d+, inv %d+)"),
-                                    FMath::RoundToInt(pFail*100.f), saveNeed, invTN)));
+                                    FMath::RoundToInt(pFail*100.f), In.SaveNeed, invTN)));
             }
             else
             {
                 SaveFailText->SetText(FText::FromString(
                     FString::Printf(TEXT("Fail Save: %d%% (save %d+)"),
-                                    FMath::RoundToInt(pFail*100.f), saveNeed)));
+                                    FMath::RoundToInt(pFail*100.f), In.SaveNeed)));
             }
         }
         else
@@ -567,22 +636,47 @@ void UTurnContextWidget::UpdateCombatEstimates(AUnitBase* Attacker, AUnitBase* T
         }
     }
 
+    if (CoverStatusText)
+        CoverStatusText->SetText(FText::FromString(CombatMath::CoverTypeToText(CoverType)));
+
+    // Damage: exact distribution from the cache, computed off-thread on a miss
+    const TSharedPtr<const FCombatEstimate> Est = FCombatEstimateCache::Get().FindOrRequest(In,
+        FOnCombatEstimateReady::CreateWeakLambda(this, [this]() { HandleCombatEstimateReady(); }));
+
+    if (!Est.IsValid())
+    {
+        EstDamageHistogram.Reset();
+        EstModelsKilledHistogram.Reset();
+        if (EstDamageText)  EstDamageText->SetText(FText::FromString(TEXT("Est. Dmg: ...")));
+        if (KillChanceText) KillChanceText->SetText(FText::GetEmpty());
+        return;
+    }
+
+    EstDamageHistogram.Reset(Est->DamagePmf.Num());
+    for (double P : Est->DamagePmf) EstDamageHistogram.Add((float)P);
+    EstModelsKilledHistogram.Reset(Est->ModelsKilledPmf.Num());
+    for (double P : Est->ModelsKilledPmf) EstModelsKilledHistogram.Add((float)P);
+
     if (EstDamageText)
     {
         if (fnpTN >= 2 && fnpTN <= 6)
         {
             EstDamageText->SetText(FText::FromString(
-                FString::Printf(TEXT("Est. Dmg: %.1f (FNP %d++)"), evDamage, fnpTN)));
+                FString::Printf(TEXT("Est. Dmg: %.1f (FNP %d++)"), Est->ExpectedDamage, fnpTN)));
         }
         else
         {
             EstDamageText->SetText(FText::FromString(
-                FString::Printf(TEXT("Est. Dmg: %.1f"), evDamage)));
+                FString::Printf(TEXT("Est. Dmg: %.1f"), Est->ExpectedDamage)));
         }
     }
 
-    if (CoverStatusText)
-        CoverStatusText->SetText(FText::FromString(CombatMath::CoverTypeToText(CoverType)));
+    if (KillChanceText)
+    {
+        KillChanceText->SetText(FText::FromString(
+            FString::Printf(TEXT("Kills: %.1f models  |  Wipe: %d%%"),
+                            Est->ExpectedModelsKilled, FMath::RoundToInt(Est->KillUnitChance * 100.0))));
+    }
 }
 
 void UTurnContextWidget::RebuildKeywordChips(const TArray<FKeywordUIInfo>& Infos)
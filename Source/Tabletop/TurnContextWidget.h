@@ -73,6 +73,11 @@ protected:
     UPROPERTY(meta=(BindWidget)) UTextBlock* SaveFailText     = nullptr;
     UPROPERTY(meta=(BindWidget)) UTextBlock* EstDamageText    = nullptr;
     UPROPERTY(meta=(BindWidget)) UTextBlock* CoverStatusText  = nullptr;
+    UPROPERTY(meta=(BindWidgetOptional)) UTextBlock* KillChanceText = nullptr;
+
+    // Full distribution of the current preview (index = damage / models removed). Empty while computing.
+    UPROPERTY(BlueprintReadOnly, Category="UI|Estimate") TArray<float> EstDamageHistogram;
+    UPROPERTY(BlueprintReadOnly, Category="UI|Estimate") TArray<float> EstModelsKilledHistogram;
     UPROPERTY(meta=(BindWidgetOptional)) UPanelWidget* PassivePanel = nullptr;
 
     UPROPERTY(meta=(BindWidget)) class UPanelWidget* KeywordPanel = nullptr;
@@ -108,6 +113,15 @@ protected:
     void RebuildKeywordChips(const TArray<FKeywordUIInfo>& Infos);
     void ClearEstimateFields();
 
+    // background estimate finished -> re-run UpdateCombatEstimates with the same args (cache hit now)
+    void HandleCombatEstimateReady();
+
+    TWeakObjectPtr<AUnitBase> EstAttacker;
+    TWeakObjectPtr<AUnitBase> EstTarget;
+    int32 EstHitMod  = 0;
+    int32 EstSaveMod = 0;
+    ECoverType EstCover {};
+
     bool IsMyTurn() const;
     
     UFUNCTION()
@@ -1 +1,20 @@
 ﻿#include "WeaponKeywords.h"
+
+FCompiledKeywordSet FCompiledKeywordSet::Build(const TArray<FWeaponKeywordData>& Keywords)
+{
+    FCompiledKeywordSet Out;
+    for (const FWeaponKeywordData& E : Keywords)
+    {
+        const int32 Idx = (int32)E.Type;
+        if (E.Type == EWeaponKeyword::None || Idx >= NumKeywords) continue;
+        if (Out.Mask & Bit(E.Type)) continue; // first entry wins, same as FindKeyword
+
+        Out.Mask       |= Bit(E.Type);
+        Out.Values[Idx] = E.Value;
+        Out.Flags[Idx]  = (E.bRerollAllHits    ? RerollAllHits    : 0)
+                        | (E.bRerollOnesHits   ? RerollOnesHits   : 0)
+                        | (E.bRerollAllWounds  ? RerollAllWounds  : 0)
+                        | (E.bRerollOnesWounds ? RerollOnesWounds : 0);
+    }
+    return Out;
+}
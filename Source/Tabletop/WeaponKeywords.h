@@ -57,3 +57,32 @@ struct FWeaponKeywordData
     UPROPERTY(EditAnywhere, BlueprintReadWrite) FGameplayTagContainer RequiresTargetTags;
     UPROPERTY(EditAnywhere, BlueprintReadWrite) FGameplayTagContainer RequiresAttackerTags;
 };
+
+/** Keyword list flattened once per weapon assignment: presence bitmask + dense per-keyword values,
+    so combat code does O(1) bit tests instead of scanning FWeaponProfile::Keywords. */
+struct TABLETOP_API FCompiledKeywordSet
+{
+    static constexpr int32 NumKeywords = (int32)EWeaponKeyword::Rending + 1;
+    static_assert(NumKeywords <= 32, "EWeaponKeyword no longer fits the uint32 mask");
+
+    enum EFlags : uint8
+    {
+        RerollAllHits    = 1 << 0,
+        RerollOnesHits   = 1 << 1,
+        RerollAllWounds  = 1 << 2,
+        RerollOnesWounds = 1 << 3,
+    };
+
+    uint32 Mask = 0;
+    int32  Values[NumKeywords] = {};
+    uint8  Flags[NumKeywords]  = {};
+
+    static FCompiledKeywordSet Build(const TArray<FWeaponKeywordData>& Keywords);
+
+    FORCEINLINE static uint32 Bit(EWeaponKeyword K) { return 1u << (uint32)K; }
+
+    FORCEINLINE bool  Has(EWeaponKeyword K) const { return (Mask & Bit(K)) != 0; }
+    FORCEINLINE bool  HasAny(uint32 Bits)   const { return (Mask & Bits) != 0; }
+    FORCEINLINE int32 Value(EWeaponKeyword K, int32 Default = 0) const { return Has(K) ? Values[(int32)K] : Default; }
+    FORCEINLINE bool  HasFlag(EWeaponKeyword K, EFlags F) const { return (Flags[(int32)K] & F) != 0; }
+};